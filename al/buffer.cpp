@@ -492,6 +492,8 @@ void PrepareUserPtr(ALCcontext *context [[maybe_unused]], ALbuffer *ALBuf, ALsiz
         case FmtDouble: return alignof(ALdouble);
         case FmtMulaw: return alignof(ALubyte);
         case FmtAlaw: return alignof(ALubyte);
+        case FmtHalf: return alignof(ALushort);
+        case FmtInt24: return alignof(ALubyte);
         case FmtIMA4: break;
         case FmtMSADPCM: break;
         }
@@ -581,6 +583,8 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_MONO_MSADPCM_SOFT, {FmtMono, FmtMSADPCM}},
         FormatMap{AL_FORMAT_MONO_MULAW,        {FmtMono, FmtMulaw}  },
         FormatMap{AL_FORMAT_MONO_ALAW_EXT,     {FmtMono, FmtAlaw}   },
+        FormatMap{AL_FORMAT_MONO_HALF_SOFT,    {FmtMono, FmtHalf}   },
+        FormatMap{AL_FORMAT_MONO_I24_SOFT,     {FmtMono, FmtInt24}  },
 
         FormatMap{AL_FORMAT_STEREO8,             {FmtStereo, FmtUByte}  },
         FormatMap{AL_FORMAT_STEREO16,            {FmtStereo, FmtShort}  },
@@ -591,6 +595,8 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_STEREO_MSADPCM_SOFT, {FmtStereo, FmtMSADPCM}},
         FormatMap{AL_FORMAT_STEREO_MULAW,        {FmtStereo, FmtMulaw}  },
         FormatMap{AL_FORMAT_STEREO_ALAW_EXT,     {FmtStereo, FmtAlaw}   },
+        FormatMap{AL_FORMAT_STEREO_HALF_SOFT,    {FmtStereo, FmtHalf}   },
+        FormatMap{AL_FORMAT_STEREO_I24_SOFT,     {FmtStereo, FmtInt24}  },
 
         FormatMap{AL_FORMAT_REAR8,        {FmtRear, FmtUByte}},
         FormatMap{AL_FORMAT_REAR16,       {FmtRear, FmtShort}},
@@ -608,6 +614,8 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_QUAD_I32,     {FmtQuad, FmtInt}  },
         FormatMap{AL_FORMAT_QUAD_FLOAT32, {FmtQuad, FmtFloat}},
         FormatMap{AL_FORMAT_QUAD_MULAW,   {FmtQuad, FmtMulaw}},
+        FormatMap{AL_FORMAT_QUAD_HALF_SOFT, {FmtQuad, FmtHalf} },
+        FormatMap{AL_FORMAT_QUAD_I24_SOFT,  {FmtQuad, FmtInt24}},
 
         FormatMap{AL_FORMAT_51CHN8,        {FmtX51, FmtUByte}},
         FormatMap{AL_FORMAT_51CHN16,       {FmtX51, FmtShort}},
@@ -615,6 +623,8 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_51CHN_I32,     {FmtX51, FmtInt}  },
         FormatMap{AL_FORMAT_51CHN_FLOAT32, {FmtX51, FmtFloat}},
         FormatMap{AL_FORMAT_51CHN_MULAW,   {FmtX51, FmtMulaw}},
+        FormatMap{AL_FORMAT_51CHN_HALF_SOFT, {FmtX51, FmtHalf} },
+        FormatMap{AL_FORMAT_51CHN_I24_SOFT,  {FmtX51, FmtInt24}},
 
         FormatMap{AL_FORMAT_61CHN8,        {FmtX61, FmtUByte}},
         FormatMap{AL_FORMAT_61CHN16,       {FmtX61, FmtShort}},
@@ -622,6 +632,8 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_61CHN_I32,     {FmtX61, FmtInt}  },
         FormatMap{AL_FORMAT_61CHN_FLOAT32, {FmtX61, FmtFloat}},
         FormatMap{AL_FORMAT_61CHN_MULAW,   {FmtX61, FmtMulaw}},
+        FormatMap{AL_FORMAT_61CHN_HALF_SOFT, {FmtX61, FmtHalf} },
+        FormatMap{AL_FORMAT_61CHN_I24_SOFT,  {FmtX61, FmtInt24}},
 
         FormatMap{AL_FORMAT_71CHN8,        {FmtX71, FmtUByte}},
         FormatMap{AL_FORMAT_71CHN16,       {FmtX71, FmtShort}},
@@ -629,18 +641,24 @@ auto DecomposeUserFormat(ALenum format) noexcept -> std::optional<DecompResult>
         FormatMap{AL_FORMAT_71CHN_I32,     {FmtX71, FmtInt}  },
         FormatMap{AL_FORMAT_71CHN_FLOAT32, {FmtX71, FmtFloat}},
         FormatMap{AL_FORMAT_71CHN_MULAW,   {FmtX71, FmtMulaw}},
+        FormatMap{AL_FORMAT_71CHN_HALF_SOFT, {FmtX71, FmtHalf} },
+        FormatMap{AL_FORMAT_71CHN_I24_SOFT,  {FmtX71, FmtInt24}},
 
         FormatMap{AL_FORMAT_BFORMAT2D_8,       {FmtBFormat2D, FmtUByte}},
         FormatMap{AL_FORMAT_BFORMAT2D_16,      {FmtBFormat2D, FmtShort}},
         FormatMap{AL_FORMAT_BFORMAT2D_I32,     {FmtBFormat2D, FmtInt}  },
         FormatMap{AL_FORMAT_BFORMAT2D_FLOAT32, {FmtBFormat2D, FmtFloat}},
         FormatMap{AL_FORMAT_BFORMAT2D_MULAW,   {FmtBFormat2D, FmtMulaw}},
+        FormatMap{AL_FORMAT_BFORMAT2D_HALF_SOFT, {FmtBFormat2D, FmtHalf} },
+        FormatMap{AL_FORMAT_BFORMAT2D_I24_SOFT,  {FmtBFormat2D, FmtInt24}},
 
         FormatMap{AL_FORMAT_BFORMAT3D_8,       {FmtBFormat3D, FmtUByte}},
         FormatMap{AL_FORMAT_BFORMAT3D_16,      {FmtBFormat3D, FmtShort}},
         FormatMap{AL_FORMAT_BFORMAT3D_I32,     {FmtBFormat3D, FmtInt}  },
         FormatMap{AL_FORMAT_BFORMAT3D_FLOAT32, {FmtBFormat3D, FmtFloat}},
         FormatMap{AL_FORMAT_BFORMAT3D_MULAW,   {FmtBFormat3D, FmtMulaw}},
+        FormatMap{AL_FORMAT_BFORMAT3D_HALF_SOFT, {FmtBFormat3D, FmtHalf} },
+        FormatMap{AL_FORMAT_BFORMAT3D_I24_SOFT,  {FmtBFormat3D, FmtInt24}},
 
         FormatMap{AL_FORMAT_UHJ2CHN8_SOFT,        {FmtUHJ2, FmtUByte}  },
         FormatMap{AL_FORMAT_UHJ2CHN16_SOFT,       {FmtUHJ2, FmtShort}  },
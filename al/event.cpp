@@ -22,6 +22,7 @@
 #include "AL/alext.h"
 
 #include "alc/context.h"
+#include "alc/inprogext.h"
 #include "alnumeric.h"
 #include "alstring.h"
 #include "core/async_event.h"
@@ -120,6 +121,17 @@ int EventThread(ALCcontext *context)
                     context->mEventCb(AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT, evt.mId, evt.mCount,
                         al::sizei(msg), msg.c_str(), context->mEventParam);
                 },
+                [context,enabledevts](AsyncSourceLowWatermarkEvent &evt)
+                {
+                    if(!context->mEventCb
+                        || !enabledevts.test(al::to_underlying(AsyncEnableBits::LowWatermark)))
+                        return;
+
+                    const auto msg = fmt::format("Source ID {} has {} sample{} queued", evt.mId,
+                        evt.mRemaining, (evt.mRemaining == 1) ? "" : "s");
+                    context->mEventCb(AL_EVENT_TYPE_SOURCE_LOW_WATERMARK_SOFT, evt.mId,
+                        evt.mRemaining, al::sizei(msg), msg.c_str(), context->mEventParam);
+                },
                 [context,enabledevts](AsyncDisconnectEvent &evt)
                 {
                     if(!context->mEventCb
@@ -144,6 +156,7 @@ constexpr std::optional<AsyncEnableBits> GetEventType(ALenum etype) noexcept
     case AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT: return AsyncEnableBits::BufferCompleted;
     case AL_EVENT_TYPE_DISCONNECTED_SOFT: return AsyncEnableBits::Disconnected;
     case AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT: return AsyncEnableBits::SourceState;
+    case AL_EVENT_TYPE_SOURCE_LOW_WATERMARK_SOFT: return AsyncEnableBits::LowWatermark;
     }
     return std::nullopt;
 }
@@ -165,6 +165,8 @@ void UpdateSourceProps(const ALsource *source, Voice *voice, ALCcontext *context
     props->Radius = source->Radius;
     props->EnhWidth = source->EnhWidth;
     props->Panning = source->mPanningEnabled ? source->mPan : 0.0f;
+    props->LowWatermark = source->mLowWatermark;
+    props->GainRamps = source->mGainRamps;
 
     props->Direct.Gain = source->Direct.Gain;
     props->Direct.GainHF = source->Direct.GainHF;
@@ -1024,6 +1026,9 @@ enum SourceProp : ALenum {
     /* AL_SOFT_source_panning */
     srcPanningEnabledSOFT = AL_PANNING_ENABLED_SOFT,
     srcPanSOFT = AL_PAN_SOFT,
+
+    /* AL_SOFT_source_low_watermark */
+    srcLowWatermarkSOFT = AL_SOURCE_LOW_WATERMARK_SOFT,
 };
 
 
@@ -1053,6 +1058,7 @@ constexpr ALuint IntValsByProp(ALenum prop)
     case AL_STEREO_MODE_SOFT:
     case AL_PANNING_ENABLED_SOFT:
     case AL_PAN_SOFT:
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
         return 1;
 
     case AL_SOURCE_RADIUS: /*AL_BYTE_RW_OFFSETS_SOFT:*/
@@ -1132,6 +1138,7 @@ constexpr ALuint Int64ValsByProp(ALenum prop)
     case AL_STEREO_MODE_SOFT:
     case AL_PANNING_ENABLED_SOFT:
     case AL_PAN_SOFT:
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
         return 1;
 
     case AL_SOURCE_RADIUS: /*AL_BYTE_RW_OFFSETS_SOFT:*/
@@ -1254,6 +1261,7 @@ constexpr ALuint FloatValsByProp(ALenum prop)
     case AL_BUFFER:
     case AL_DIRECT_FILTER:
     case AL_AUXILIARY_SEND_FILTER:
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
         break; /* i/i64 only */
     case AL_SAMPLE_OFFSET_LATENCY_SOFT:
     case AL_SAMPLE_OFFSET_CLOCK_SOFT:
@@ -1327,6 +1335,7 @@ constexpr ALuint DoubleValsByProp(ALenum prop)
     case AL_BUFFER:
     case AL_DIRECT_FILTER:
     case AL_AUXILIARY_SEND_FILTER:
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
         break; /* i/i64 only */
     case AL_SAMPLE_OFFSET_LATENCY_SOFT:
     case AL_SAMPLE_OFFSET_CLOCK_SOFT:
@@ -1737,6 +1746,17 @@ NOINLINE void SetProperty(ALsource *const Source, ALCcontext *const Context, con
         Source->mPan = static_cast<float>(values[0]);
         return UpdateSourceProps(Source, Context);
 
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
+        if constexpr(std::is_integral_v<T>)
+        {
+            CheckSize(1);
+            CheckValue(values[0] >= 0 && uint64_t(values[0]) <= std::numeric_limits<uint>::max());
+
+            Source->mLowWatermark = static_cast<uint>(values[0]);
+            return UpdateSourceProps(Source, Context);
+        }
+        break;
+
     case AL_STEREO_ANGLES:
         CheckSize(2);
         if constexpr(std::is_floating_point_v<T>)
@@ -2179,6 +2199,15 @@ NOINLINE void GetProperty(ALsource *const Source, ALCcontext *const Context, con
         values[0] = static_cast<T>(Source->mPan);
         return;
 
+    case AL_SOURCE_LOW_WATERMARK_SOFT:
+        if constexpr(std::is_integral_v<T>)
+        {
+            CheckSize(1);
+            values[0] = static_cast<T>(Source->mLowWatermark);
+            return;
+        }
+        break;
+
     case AL_STEREO_ANGLES:
         if constexpr(std::is_floating_point_v<T>)
         {
@@ -2535,6 +2564,7 @@ void StartSources(ALCcontext *const context, const std::span<ALsource*> srchandl
         voicelist = context->getVoicesSpan();
     }
 
+    const auto clocktime = device->getClockTime();
     auto voiceiter = voicelist.begin();
     ALuint vidx{0};
     VoiceChange *tail{}, *cur{};
@@ -2608,6 +2638,11 @@ void StartSources(ALCcontext *const context, const std::span<ALsource*> srchandl
             break;
         }
 
+        /* Gain ramps that finished before this run starts don't carry over
+         * to it. Ramps scheduled for it, like a fade-in, are kept.
+         */
+        source->mGainRamps.dropFinished(std::max(start_time, clocktime));
+
         /* Find the next unused voice to play this source with. */
         for(;voiceiter != voicelist.end();++voiceiter,++vidx)
         {
@@ -3324,6 +3359,146 @@ catch(std::exception &e) {
     ERR("Caught exception: {}", e.what());
 }
 
+FORCE_ALIGN DECL_FUNCEXT5(void, alSourceRampf,SOFT, ALuint,source, ALenum,param, ALfloat,value, ALint64SOFT,start_time, ALint64SOFT,duration)
+FORCE_ALIGN void AL_APIENTRY alSourceRampfDirectSOFT(ALCcontext *context, ALuint source,
+    ALenum param, ALfloat value, ALint64SOFT start_time, ALint64SOFT duration) noexcept
+try {
+    std::lock_guard<std::mutex> sourcelock{context->mSourceLock};
+    ALsource *Source{LookupSource(context, source)};
+    if(!Source)
+        context->throw_error(AL_INVALID_NAME, "Invalid source ID {}", source);
+
+    if(param != AL_RAMP_GAIN_SOFT)
+        context->throw_error(AL_INVALID_ENUM, "Invalid source ramp property {:#04x}",
+            as_unsigned(param));
+    if(!(value >= 0.0f && std::isfinite(value)))
+        context->throw_error(AL_INVALID_VALUE, "Ramp gain {} out of range", value);
+    if(start_time < 0)
+        context->throw_error(AL_INVALID_VALUE, "Invalid time point {}", start_time);
+    if(duration < 0)
+        context->throw_error(AL_INVALID_VALUE, "Invalid ramp duration {}", duration);
+
+    Source->mGainRamps.add(value, nanoseconds{start_time}, nanoseconds{duration});
+    UpdateSourceProps(Source, context);
+}
+catch(al::base_exception&) {
+}
+catch(std::exception &e) {
+    ERR("Caught exception: {}", e.what());
+}
+
+FORCE_ALIGN DECL_FUNCEXT6(void, alGetSourceStatusv,SOFT, ALsizei,n, const ALuint*,sources, ALint*,states, ALint64SOFT*,offsets, ALint*,processed, ALint64SOFT*,clocktime)
+FORCE_ALIGN void AL_APIENTRY alGetSourceStatusvDirectSOFT(ALCcontext *context, ALsizei n,
+    const ALuint *sources, ALint *states, ALint64SOFT *offsets, ALint *processed,
+    ALint64SOFT *clocktime) noexcept
+try {
+    if(n < 0)
+        context->throw_error(AL_INVALID_VALUE, "Querying {} sources", n);
+    if(n > 0 && !sources)
+        context->throw_error(AL_INVALID_VALUE, "NULL pointer");
+
+    struct SourceStatus {
+        ALsource *mSource;
+        Voice *mVoice;
+        const VoiceBufferItem *mCurrent;
+        int64_t mReadPos;
+    };
+    const auto sids = std::span{sources, static_cast<ALuint>(std::max(n, 0))};
+    auto status = std::vector<SourceStatus>(sids.size());
+
+    std::lock_guard<std::mutex> sourcelock{context->mSourceLock};
+    auto lookup_src = [context](const ALuint sid) -> SourceStatus
+    {
+        if(ALsource *src{LookupSource(context, sid)})
+            return SourceStatus{src, nullptr, nullptr, 0};
+        context->throw_error(AL_INVALID_NAME, "Invalid source ID {}", sid);
+    };
+    std::transform(sids.begin(), sids.end(), status.begin(), lookup_src);
+
+    /* Read the voice positions for all the sources in one pass, retrying if
+     * the mixer ran in the middle of it. This gives a consistent snapshot
+     * relative to a single clock time, with only one wait on the mixer for
+     * the whole batch instead of one per source and property.
+     */
+    auto *device = context->mALDevice.get();
+    auto clocktime_ns = nanoseconds{};
+    uint refcount{};
+    do {
+        refcount = device->waitForMix();
+        clocktime_ns = device->getClockTime();
+        for(auto &srcstatus : status)
+        {
+            srcstatus.mVoice = GetSourceVoice(srcstatus.mSource, context);
+            if(Voice *voice{srcstatus.mVoice})
+            {
+                srcstatus.mCurrent = voice->mCurrentBuffer.load(std::memory_order_relaxed);
+                srcstatus.mReadPos = int64_t{voice->mPosition.load(std::memory_order_relaxed)}
+                    << MixerFracBits;
+                srcstatus.mReadPos += voice->mPositionFrac.load(std::memory_order_relaxed);
+            }
+            else
+            {
+                srcstatus.mCurrent = nullptr;
+                srcstatus.mReadPos = 0;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while(refcount != device->mMixCount.load(std::memory_order_relaxed));
+
+    if(clocktime)
+        *clocktime = clocktime_ns.count();
+
+    for(size_t i{0};i < status.size();++i)
+    {
+        const auto &srcstatus = status[i];
+        ALsource *source{srcstatus.mSource};
+        const ALenum state{GetSourceState(source, srcstatus.mVoice)};
+        if(states)
+            states[i] = state;
+
+        /* Same as AL_SAMPLE_OFFSET_CLOCK_SOFT, a 32.32 fixed-point sample
+         * offset relative to the start of the queue.
+         */
+        if(offsets)
+        {
+            int64_t readPos{srcstatus.mReadPos};
+            if(srcstatus.mVoice)
+            {
+                for(auto &item : source->mQueue)
+                {
+                    if(&item == srcstatus.mCurrent) break;
+                    readPos += int64_t{item.mSampleLen} << MixerFracBits;
+                }
+            }
+            if(readPos > std::numeric_limits<int64_t>::max() >> (32-MixerFracBits))
+                offsets[i] = std::numeric_limits<int64_t>::max();
+            else
+                offsets[i] = readPos << (32-MixerFracBits);
+        }
+
+        /* Same as AL_BUFFERS_PROCESSED. */
+        if(processed)
+        {
+            int played{0};
+            if(!source->Looping && source->SourceType == AL_STREAMING && state != AL_INITIAL)
+            {
+                for(auto &item : source->mQueue)
+                {
+                    if(&item == srcstatus.mCurrent)
+                        break;
+                    ++played;
+                }
+            }
+            processed[i] = played;
+        }
+    }
+}
+catch(al::base_exception&) {
+}
+catch(std::exception &e) {
+    ERR("Caught exception: {}", e.what());
+}
+
 
 AL_API DECL_FUNC1(void, alSourcePause, ALuint,source)
 FORCE_ALIGN void AL_APIENTRY alSourcePauseDirect(ALCcontext *context, ALuint source) noexcept
@@ -5084,4 +5259,11 @@ void ALsource::eaxCommit()
     eax_commit_filters();
 }
 
+void ALsource::eaxCommitAndUpdate()
+{
+    eaxCommit();
+    if(std::exchange(mPropsDirty, false))
+        UpdateSourceProps(this, mEaxAlContext);
+}
+
 #endif // ALSOFT_EAX
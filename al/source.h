@@ -89,6 +89,7 @@ struct ALsource {
     SpatializeMode mSpatialize{SpatializeMode::Auto};
     SourceStereo mStereoMode{SourceStereo::Normal};
     bool mPanningEnabled{false};
+    uint mLowWatermark{0u};
 
     bool DryGainHFAuto{true};
     bool WetGainAuto{true};
@@ -109,6 +110,8 @@ struct ALsource {
     float EnhWidth{0.593f};
     float mPan{0.0f};
 
+    GainRampList mGainRamps;
+
     /** Direct filter and auxiliary send info. */
     struct DirectData {
         float Gain{};
@@ -171,6 +174,10 @@ public:
     void eaxInitialize(ALCcontext *context) noexcept;
     void eaxDispatch(const EaxCall& call) { call.is_get() ? eax_get(call) : eax_set(call); }
     void eaxCommit();
+    /* Commits this source's EAX changes and updates its voice, independent of
+     * the rest of the context.
+     */
+    void eaxCommitAndUpdate();
     void eaxMarkAsChanged() noexcept { mEaxChanged = true; }
 
     static ALsource* EaxLookupSource(ALCcontext& al_context, ALuint source_id) noexcept;
@@ -166,9 +166,11 @@ enum PropertyValue : ALenum {
     MaxDebugGroupDepthProp = AL_MAX_DEBUG_GROUP_STACK_DEPTH_EXT,
     MaxLabelLengthProp = AL_MAX_LABEL_LENGTH_EXT,
     ContextFlagsProp = AL_CONTEXT_FLAGS_EXT,
+    PoolAllocationsProp = AL_POOL_ALLOCATIONS_SOFT,
 #if ALSOFT_EAX
     EaxRamSizeProp = AL_EAX_RAM_SIZE,
     EaxRamFreeProp = AL_EAX_RAM_FREE,
+    EaxCommitsAvoidedProp = AL_EAX_COMMITS_AVOIDED_SOFT,
 #endif
 };
 
@@ -266,6 +268,10 @@ void GetValue(ALCcontext *context, ALenum pname, T *values)
         *values = cast_value(context->mContextFlags.to_ulong());
         return;
 
+    case AL_POOL_ALLOCATIONS_SOFT:
+        *values = cast_value(context->mPoolAllocCount.load(std::memory_order_relaxed));
+        return;
+
 #if ALSOFT_EAX
 #define EAX_ERROR "[alGetInteger] EAX not enabled"
 
@@ -289,6 +295,10 @@ void GetValue(ALCcontext *context, ALenum pname, T *values)
         ERR(EAX_ERROR);
         break;
 
+    case AL_EAX_COMMITS_AVOIDED_SOFT:
+        *values = cast_value(context->eaxCommitsAvoided());
+        return;
+
 #undef EAX_ERROR
 #endif // ALSOFT_EAX
     }
@@ -39,6 +39,7 @@
 #include <chrono>
 #include <climits>
 #include <cmath>
+#include <condition_variable>
 #include <csignal>
 #include <cstddef>
 #include <cstdio>
@@ -46,6 +47,7 @@
 #include <cstring>
 #include <exception>
 #include <functional>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -57,6 +59,7 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -279,6 +282,169 @@ std::array BackendList{
 BackendFactory *PlaybackFactory{};
 BackendFactory *CaptureFactory{};
 
+/* How long to wait on a backend to initialize before starting on the next. */
+constexpr auto BackendProbeDelay = std::chrono::milliseconds{50};
+
+/* How long library shutdown waits on backend inits that are still running.
+ * On Windows, other threads are already terminated by the time static objects
+ * are destroyed, so there's nothing to wait for.
+ */
+#ifdef _WIN32
+constexpr auto BackendProbeShutdownWait = std::chrono::milliseconds{0};
+#else
+constexpr auto BackendProbeShutdownWait = std::chrono::milliseconds{500};
+#endif
+
+/* A backend init running on its own thread. */
+struct BackendProbe {
+    std::future<bool> mResult;
+    std::thread mThread;
+};
+
+/* Backend inits that were still running when the backends got selected. They
+ * finish in the background and are joined at library shutdown, giving up on
+ * any that are stuck.
+ */
+class LeftoverBackendProbes {
+    std::vector<BackendProbe> mProbes;
+
+public:
+    LeftoverBackendProbes() = default;
+    LeftoverBackendProbes(const LeftoverBackendProbes&) = delete;
+    ~LeftoverBackendProbes()
+    {
+        const auto deadline = std::chrono::steady_clock::now() + BackendProbeShutdownWait;
+        for(auto &probe : mProbes)
+        {
+            if(probe.mResult.wait_until(deadline) == std::future_status::ready)
+                probe.mThread.join();
+            else
+                probe.mThread.detach();
+        }
+    }
+    auto operator=(const LeftoverBackendProbes&) -> LeftoverBackendProbes& = delete;
+
+    void add(BackendProbe&& probe) { mProbes.emplace_back(std::move(probe)); }
+
+    /* This is created after the factories of the probes it gets, so it's
+     * destroyed before them.
+     */
+    static auto Get() -> LeftoverBackendProbes&
+    {
+        static auto probes = LeftoverBackendProbes{};
+        return probes;
+    }
+};
+
+/* Runs backend inits in priority order on the calling thread. If one takes
+ * longer than BackendProbeDelay, the next one is started on another thread,
+ * and so on, so one backend that's slow to fail doesn't hold up the rest.
+ */
+class BackendProber {
+    std::span<const BackendInfo> mBackends;
+    std::vector<BackendProbe> mProbes;
+
+    std::mutex mLock;
+    std::condition_variable mCond;
+    size_t mNextProbe{0};
+    std::chrono::steady_clock::time_point mLastStart{std::chrono::steady_clock::now()};
+    bool mDone{false};
+
+    std::thread mStaggerThread;
+
+    void staggerProc();
+
+public:
+    explicit BackendProber(const std::span<const BackendInfo> backends)
+        : mBackends{backends}, mProbes(backends.size())
+    { mStaggerThread = std::thread{&BackendProber::staggerProc, this}; }
+    BackendProber(const BackendProber&) = delete;
+    ~BackendProber();
+    auto operator=(const BackendProber&) -> BackendProber& = delete;
+
+    /* Returns whether the given backend initialized. Backends must be checked
+     * in order. One that hasn't been started yet is initialized on the
+     * calling thread, otherwise its result is waited on.
+     */
+    auto init(size_t idx) -> bool;
+};
+
+void BackendProber::staggerProc()
+{
+    auto lock = std::unique_lock{mLock};
+    while(!mDone && mNextProbe < mBackends.size())
+    {
+        const auto deadline = mLastStart + BackendProbeDelay;
+        if(std::chrono::steady_clock::now() < deadline)
+        {
+            mCond.wait_until(lock, deadline);
+            continue;
+        }
+
+        auto &factory = mBackends[mNextProbe].getFactory();
+        auto promise = std::promise<bool>{};
+        auto &probe = mProbes[mNextProbe];
+        probe.mResult = promise.get_future();
+        try {
+            probe.mThread = std::thread{[&factory](std::promise<bool> result)
+            {
+                try {
+                    result.set_value(factory.init());
+                }
+                catch(...) {
+                    result.set_exception(std::current_exception());
+                }
+            }, std::move(promise)};
+        }
+        catch(std::exception &e) {
+            /* Leave the rest for the calling thread. */
+            ERR("Failed to start backend probe thread: {}", e.what());
+            probe.mResult = {};
+            break;
+        }
+        ++mNextProbe;
+        mLastStart = std::chrono::steady_clock::now();
+    }
+}
+
+BackendProber::~BackendProber()
+{
+    {
+        auto lock = std::lock_guard{mLock};
+        mDone = true;
+    }
+    mCond.notify_all();
+    mStaggerThread.join();
+
+    /* Let any lower priority backends that were started finish in the
+     * background, rather than wait on them here.
+     */
+    for(auto &probe : mProbes)
+    {
+        if(probe.mThread.joinable())
+            LeftoverBackendProbes::Get().add(std::move(probe));
+    }
+}
+
+auto BackendProber::init(size_t idx) -> bool
+{
+    auto lock = std::unique_lock{mLock};
+    if(idx == mNextProbe)
+    {
+        ++mNextProbe;
+        mLastStart = std::chrono::steady_clock::now();
+        lock.unlock();
+        mCond.notify_all();
+        return mBackends[idx].getFactory().init();
+    }
+    lock.unlock();
+
+    auto &probe = mProbes[idx];
+    const auto ret = probe.mResult.get();
+    probe.mThread.join();
+    return ret;
+}
+
 
 [[nodiscard]] constexpr auto GetNoErrorString() noexcept { return "No Error"; }
 [[nodiscard]] constexpr auto GetInvalidDeviceString() noexcept { return "Invalid Device"; }
@@ -305,6 +471,14 @@ std::vector<std::string> alcCaptureDeviceArray;
 std::string alcAllDevicesList;
 std::string alcCaptureDeviceList;
 
+/* Whether the enumerated device lists can be reused until the device event
+ * count changes, and the event count they were enumerated at.
+ */
+bool alcAllDevicesCacheable{false};
+bool alcCaptureDevicesCacheable{false};
+std::optional<uint> alcAllDevicesSerial;
+std::optional<uint> alcCaptureDevicesSerial;
+
 /* Default is always the first in the list */
 std::string alcDefaultAllDevicesSpecifier;
 std::string alcCaptureDefaultDeviceSpecifier;
@@ -314,8 +488,9 @@ std::atomic<ALCenum> LastNullDeviceError{ALC_NO_ERROR};
 /* Flag to trap ALC device errors */
 bool TrapALCError{false};
 
-/* One-time configuration init control */
+/* One-time configuration and backend init control */
 std::once_flag alc_config_once{};
+std::once_flag alc_backends_once{};
 
 /* Flag to specify if alcSuspendContext/alcProcessContext should defer/process
  * updates.
@@ -325,6 +500,9 @@ bool SuspendDefers{true};
 /* Initial seed for dithering. */
 constexpr uint DitherRNGSeed{22222u};
 
+/* Upper limit for the number of voices a context can preallocate. */
+constexpr int MaxPreallocVoices{65536};
+
 
 /************************************************
  * ALC information
@@ -353,6 +531,8 @@ constexpr uint DitherRNGSeed{22222u};
         "ALC_EXT_disconnect "
         "ALC_EXT_EFX "
         "ALC_EXT_thread_local_context "
+        "ALC_SOFTX_capture_view "
+        "ALC_SOFTX_context_preallocation "
         "ALC_SOFT_device_clock "
         "ALC_SOFT_HRTF "
         "ALC_SOFT_loopback "
@@ -580,6 +760,73 @@ void alc_initconfig()
         ReverbBoost *= std::pow(10.0f, valf / 20.0f);
     }
 
+    LoopbackBackendFactory::getFactory().init();
+
+    if(auto exclopt = ConfigValueStr({}, {}, "excludefx"sv))
+    {
+        std::string_view exclude{*exclopt};
+        while(!exclude.empty())
+        {
+            const auto nextpos = exclude.find(',');
+            const auto entry = exclude.substr(0, nextpos);
+            exclude.remove_prefix((nextpos < exclude.size()) ? nextpos+1 : exclude.size());
+
+            std::for_each(gEffectList.cbegin(), gEffectList.cend(),
+                [entry](const EffectList &effectitem) noexcept
+                {
+                    if(entry == std::data(effectitem.name))
+                        DisabledEffects.set(effectitem.type);
+                });
+        }
+    }
+
+    InitEffect(&ALCcontext::sDefaultEffect);
+    auto defrevopt = al::getenv("ALSOFT_DEFAULT_REVERB");
+    if(!defrevopt) defrevopt = ConfigValueStr({}, {}, "default-reverb"sv);
+    if(defrevopt) LoadReverbPreset(*defrevopt, &ALCcontext::sDefaultEffect);
+
+#if ALSOFT_EAX
+    if(const auto eax_enable_opt = ConfigValueBool({}, "eax", "enable"))
+    {
+        eax_g_is_enabled = *eax_enable_opt;
+        if(!eax_g_is_enabled)
+            TRACE("EAX disabled by a configuration.");
+    }
+    else
+        eax_g_is_enabled = true;
+
+    if((DisabledEffects.test(EAXREVERB_EFFECT) || DisabledEffects.test(CHORUS_EFFECT))
+        && eax_g_is_enabled)
+    {
+        eax_g_is_enabled = false;
+        TRACE("EAX disabled because {} disabled.",
+            (DisabledEffects.test(EAXREVERB_EFFECT) && DisabledEffects.test(CHORUS_EFFECT))
+                ? "EAXReverb and Chorus are"sv :
+            DisabledEffects.test(EAXREVERB_EFFECT) ? "EAXReverb is"sv :
+            DisabledEffects.test(CHORUS_EFFECT) ? "Chorus is"sv : ""sv);
+    }
+
+    if(eax_g_is_enabled)
+    {
+        if(auto optval = al::getenv("ALSOFT_EAX_TRACE_COMMITS"))
+        {
+            EaxTraceCommits = al::case_compare(*optval, "true"sv) == 0
+                || strtol(optval->c_str(), nullptr, 0) == 1;
+        }
+        else
+            EaxTraceCommits = GetConfigValueBool({}, "eax"sv, "trace-commits"sv, false);
+    }
+#endif // ALSOFT_EAX
+}
+inline void InitConfig()
+{ std::call_once(alc_config_once, [](){alc_initconfig();}); }
+
+/* Initializes the backends, and selects the highest priority ones that can do
+ * playback and capture. This is separate from the config init so apps that
+ * only use loopback devices or query strings don't pay for it.
+ */
+void alc_initbackends()
+{
     auto BackendListEnd = BackendList.end();
     auto devopt = al::getenv("ALSOFT_DRIVERS");
     if(!devopt) devopt = ConfigValueStr({}, {}, "drivers"sv);
@@ -651,19 +898,22 @@ void alc_initconfig()
         }
     }
 
-    std::for_each(BackendList.begin(), BackendListEnd, [](BackendInfo &backend) -> void
+    /* Initialize the backends in priority order, without touching the lower
+     * priority ones when the first ones are quick.
+     */
+    const auto backends = std::span{BackendList.begin(), BackendListEnd};
+    auto prober = BackendProber{backends};
+    for(size_t idx{0};idx < backends.size() && !(PlaybackFactory && CaptureFactory);++idx)
     {
-        if(PlaybackFactory && CaptureFactory)
-            return;
-
-        BackendFactory &factory = backend.getFactory();
-        if(!factory.init())
+        const auto &backend = backends[idx];
+        if(!prober.init(idx))
         {
             WARN("Failed to initialize backend \"{}\"", backend.name);
-            return;
+            continue;
         }
 
         TRACE("Initialized backend \"{}\"", backend.name);
+        BackendFactory &factory = backend.getFactory();
         if(!PlaybackFactory && factory.querySupport(BackendType::Playback))
         {
             PlaybackFactory = &factory;
@@ -674,73 +924,34 @@ void alc_initconfig()
             CaptureFactory = &factory;
             TRACE("Added \"{}\" for capture", backend.name);
         }
-    });
-
-    LoopbackBackendFactory::getFactory().init();
+    }
 
     if(!PlaybackFactory)
         WARN("No playback backend available!");
     if(!CaptureFactory)
         WARN("No capture backend available!");
 
-    if(auto exclopt = ConfigValueStr({}, {}, "excludefx"sv))
-    {
-        std::string_view exclude{*exclopt};
-        while(!exclude.empty())
-        {
-            const auto nextpos = exclude.find(',');
-            const auto entry = exclude.substr(0, nextpos);
-            exclude.remove_prefix((nextpos < exclude.size()) ? nextpos+1 : exclude.size());
-
-            std::for_each(gEffectList.cbegin(), gEffectList.cend(),
-                [entry](const EffectList &effectitem) noexcept
-                {
-                    if(entry == std::data(effectitem.name))
-                        DisabledEffects.set(effectitem.type);
-                });
-        }
-    }
-
-    InitEffect(&ALCcontext::sDefaultEffect);
-    auto defrevopt = al::getenv("ALSOFT_DEFAULT_REVERB");
-    if(!defrevopt) defrevopt = ConfigValueStr({}, {}, "default-reverb"sv);
-    if(defrevopt) LoadReverbPreset(*defrevopt, &ALCcontext::sDefaultEffect);
-
-#if ALSOFT_EAX
-    if(const auto eax_enable_opt = ConfigValueBool({}, "eax", "enable"))
-    {
-        eax_g_is_enabled = *eax_enable_opt;
-        if(!eax_g_is_enabled)
-            TRACE("EAX disabled by a configuration.");
-    }
-    else
-        eax_g_is_enabled = true;
-
-    if((DisabledEffects.test(EAXREVERB_EFFECT) || DisabledEffects.test(CHORUS_EFFECT))
-        && eax_g_is_enabled)
-    {
-        eax_g_is_enabled = false;
-        TRACE("EAX disabled because {} disabled.",
-            (DisabledEffects.test(EAXREVERB_EFFECT) && DisabledEffects.test(CHORUS_EFFECT))
-                ? "EAXReverb and Chorus are"sv :
-            DisabledEffects.test(EAXREVERB_EFFECT) ? "EAXReverb is"sv :
-            DisabledEffects.test(CHORUS_EFFECT) ? "Chorus is"sv : ""sv);
-    }
-
-    if(eax_g_is_enabled)
-    {
-        if(auto optval = al::getenv("ALSOFT_EAX_TRACE_COMMITS"))
-        {
-            EaxTraceCommits = al::case_compare(*optval, "true"sv) == 0
-                || strtol(optval->c_str(), nullptr, 0) == 1;
-        }
-        else
-            EaxTraceCommits = GetConfigValueBool({}, "eax"sv, "trace-commits"sv, false);
-    }
-#endif // ALSOFT_EAX
+    /* Device lists can be kept between enumerations when the backend reports
+     * when they change.
+     */
+    auto has_device_events = [](BackendFactory *factory, const BackendType type)
+    {
+        return factory
+            && factory->queryEventSupport(alc::EventType::DeviceAdded, type)
+                == alc::EventSupport::FullSupport
+            && factory->queryEventSupport(alc::EventType::DeviceRemoved, type)
+                == alc::EventSupport::FullSupport
+            && factory->queryEventSupport(alc::EventType::DefaultDeviceChanged, type)
+                == alc::EventSupport::FullSupport;
+    };
+    alcAllDevicesCacheable = has_device_events(PlaybackFactory, BackendType::Playback);
+    alcCaptureDevicesCacheable = has_device_events(CaptureFactory, BackendType::Capture);
+}
+inline void InitBackends()
+{
+    InitConfig();
+    std::call_once(alc_backends_once, [](){alc_initbackends();});
 }
-inline void InitConfig()
-{ std::call_once(alc_config_once, [](){alc_initconfig();}); }
 
 
 /************************************************
@@ -748,51 +959,62 @@ inline void InitConfig()
  ************************************************/
 void ProbeAllDevicesList()
 {
-    InitConfig();
+    InitBackends();
 
     std::lock_guard<std::recursive_mutex> listlock{ListLock};
     if(!PlaybackFactory)
     {
         decltype(alcAllDevicesArray){}.swap(alcAllDevicesArray);
         decltype(alcAllDevicesList){}.swap(alcAllDevicesList);
+        return;
     }
-    else
-    {
-        alcAllDevicesArray = PlaybackFactory->enumerate(BackendType::Playback);
-        if(const auto prefix = GetDevicePrefix(); !prefix.empty())
-            std::for_each(alcAllDevicesArray.begin(), alcAllDevicesArray.end(),
-                [prefix](std::string &name) { name.insert(0, prefix); });
 
-        decltype(alcAllDevicesList){}.swap(alcAllDevicesList);
-        if(alcAllDevicesArray.empty())
-            alcAllDevicesList += '\0';
-        else for(auto &devname : alcAllDevicesArray)
-            alcAllDevicesList.append(devname) += '\0';
-    }
+    /* Get the event count before enumerating, so a change during enumeration
+     * will cause the next call to enumerate again.
+     */
+    const auto serial = alc::PlaybackEventCount.load(std::memory_order_acquire);
+    if(alcAllDevicesCacheable && alcAllDevicesSerial == serial)
+        return;
+    alcAllDevicesSerial = serial;
+
+    alcAllDevicesArray = PlaybackFactory->enumerate(BackendType::Playback);
+    if(const auto prefix = GetDevicePrefix(); !prefix.empty())
+        std::for_each(alcAllDevicesArray.begin(), alcAllDevicesArray.end(),
+            [prefix](std::string &name) { name.insert(0, prefix); });
+
+    decltype(alcAllDevicesList){}.swap(alcAllDevicesList);
+    if(alcAllDevicesArray.empty())
+        alcAllDevicesList += '\0';
+    else for(auto &devname : alcAllDevicesArray)
+        alcAllDevicesList.append(devname) += '\0';
 }
 void ProbeCaptureDeviceList()
 {
-    InitConfig();
+    InitBackends();
 
     std::lock_guard<std::recursive_mutex> listlock{ListLock};
     if(!CaptureFactory)
     {
         decltype(alcCaptureDeviceArray){}.swap(alcCaptureDeviceArray);
         decltype(alcCaptureDeviceList){}.swap(alcCaptureDeviceList);
+        return;
     }
-    else
-    {
-        alcCaptureDeviceArray = CaptureFactory->enumerate(BackendType::Capture);
-        if(const auto prefix = GetDevicePrefix(); !prefix.empty())
-            std::for_each(alcCaptureDeviceArray.begin(), alcCaptureDeviceArray.end(),
-                [prefix](std::string &name) { name.insert(0, prefix); });
 
-        decltype(alcCaptureDeviceList){}.swap(alcCaptureDeviceList);
-        if(alcCaptureDeviceArray.empty())
-            alcCaptureDeviceList += '\0';
-        else for(auto &devname : alcCaptureDeviceArray)
-            alcCaptureDeviceList.append(devname) += '\0';
-    }
+    const auto serial = alc::CaptureEventCount.load(std::memory_order_acquire);
+    if(alcCaptureDevicesCacheable && alcCaptureDevicesSerial == serial)
+        return;
+    alcCaptureDevicesSerial = serial;
+
+    alcCaptureDeviceArray = CaptureFactory->enumerate(BackendType::Capture);
+    if(const auto prefix = GetDevicePrefix(); !prefix.empty())
+        std::for_each(alcCaptureDeviceArray.begin(), alcCaptureDeviceArray.end(),
+            [prefix](std::string &name) { name.insert(0, prefix); });
+
+    decltype(alcCaptureDeviceList){}.swap(alcCaptureDeviceList);
+    if(alcCaptureDeviceArray.empty())
+        alcCaptureDeviceList += '\0';
+    else for(auto &devname : alcCaptureDeviceArray)
+        alcCaptureDeviceList.append(devname) += '\0';
 }
 
 
@@ -1074,6 +1296,143 @@ inline void UpdateClockBase(al::Device *device)
     device->mSamplesDone.store(0, std::memory_order_relaxed);
 }
 
+/* The device properties effect states are prepared with. */
+struct EffectRendererState {
+    uint mSampleRate{};
+    uint mAmbiOrder{};
+    float mXOverFreq{};
+    RenderMode mRenderMode{};
+    bool m2DMixing{};
+    bool mUhjEncoding{};
+
+    explicit EffectRendererState(const al::Device *device) noexcept
+        : mSampleRate{device->mSampleRate}, mAmbiOrder{device->mAmbiOrder}
+        , mXOverFreq{device->mXOverFreq}, mRenderMode{device->mRenderMode}
+        , m2DMixing{device->m2DMixing}, mUhjEncoding{device->mUhjEncoder != nullptr}
+    { }
+
+    bool operator==(const EffectRendererState&) const noexcept = default;
+};
+
+/* The device properties voices are prepared with. If a reset leaves these
+ * unchanged, the existing voice and effect state (filter histories, delay
+ * lines, reverb tails, etc) remains valid and is kept instead of being
+ * reinitialized.
+ */
+struct RendererState {
+    EffectRendererState mEffect;
+    const FloatBufferLine *mDryBuffer{};
+    size_t mDryChannels{};
+    const HrtfStore *mHrtf{};
+    float mAvgSpeakerDist{};
+
+    explicit RendererState(const al::Device *device) noexcept
+        : mEffect{device}, mDryBuffer{device->Dry.Buffer.data()}
+        , mDryChannels{device->Dry.Buffer.size()}, mHrtf{device->mHrtf.get()}
+        , mAvgSpeakerDist{device->AvgSpeakerDist}
+    { }
+
+    bool operator==(const RendererState&) const noexcept = default;
+};
+
+/**
+ * Requests the mixer to fade out and hold the output, so the renderer can be
+ * updated while the backend keeps running. The output stays silent until the
+ * hold is released. Returns false if the mixer didn't respond in time, in
+ * which case the backend needs to be stopped instead.
+ */
+auto HoldDeviceOutput(al::Device *device) -> bool
+{
+    using std::chrono::steady_clock;
+    using OutputHold = DeviceBase::OutputHold;
+
+    device->mOutputHold.store(OutputHold::Requested, std::memory_order_release);
+
+    /* The mixer should get to it within a couple of updates, as long as the
+     * backend is still processing.
+     */
+    const auto timeout = steady_clock::now() + std::chrono::milliseconds{20}
+        + nanoseconds{seconds{device->mBufferSize}}*2 / device->mSampleRate;
+    while(device->mOutputHold.load(std::memory_order_acquire) != OutputHold::Held)
+    {
+        if(steady_clock::now() >= timeout)
+        {
+            auto hold = OutputHold::Requested;
+            if(device->mOutputHold.compare_exchange_strong(hold, OutputHold::None,
+                std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                WARN("Timed out waiting for the output to hold");
+                return false;
+            }
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    return true;
+}
+
+/**
+ * Resets the backend with the requested format, updating the device with
+ * the format actually set. Returns false if the backend failed to reset.
+ */
+auto ResetBackendFormat(al::Device *device, const al::Device::FormatRequest &req) -> bool
+{
+    device->mSampleRate = req.mSampleRate;
+    device->mUpdateSize = req.mUpdateSize;
+    device->mBufferSize = req.mBufferSize;
+    device->FmtChans = req.mChannels;
+    device->FmtType = req.mType;
+    device->mAmbiOrder = req.mAmbiOrder;
+    if(device->FmtChans == DevFmtAmbi3D)
+    {
+        device->mAmbiLayout = req.mAmbiLayout;
+        device->mAmbiScale = req.mAmbiScale;
+    }
+    device->Flags.set(FrequencyRequest, req.mFrequencyRequest)
+        .set(ChannelsRequest, req.mChannelsRequest)
+        .set(SampleTypeRequest, req.mSampleTypeRequest);
+
+    TRACE("Pre-reset: {}{}, {}{}, {}{}hz, {} / {} buffer",
+        device->Flags.test(ChannelsRequest)?"*":"", DevFmtChannelsString(device->FmtChans),
+        device->Flags.test(SampleTypeRequest)?"*":"", DevFmtTypeString(device->FmtType),
+        device->Flags.test(FrequencyRequest)?"*":"", device->mSampleRate,
+        device->mUpdateSize, device->mBufferSize);
+
+    try {
+        auto backend = device->Backend.get();
+        if(!backend->reset())
+            throw al::backend_exception{al::backend_error::DeviceError, "Device reset failure"};
+    }
+    catch(std::exception &e) {
+        ERR("Device error: {}", e.what());
+        device->handleDisconnect("{}", e.what());
+        return false;
+    }
+
+    if(device->FmtChans != req.mChannels && device->Flags.test(ChannelsRequest))
+    {
+        ERR("Failed to set {}, got {} instead", DevFmtChannelsString(req.mChannels),
+            DevFmtChannelsString(device->FmtChans));
+        device->Flags.reset(ChannelsRequest);
+    }
+    if(device->FmtType != req.mType && device->Flags.test(SampleTypeRequest))
+    {
+        ERR("Failed to set {}, got {} instead", DevFmtTypeString(req.mType),
+            DevFmtTypeString(device->FmtType));
+        device->Flags.reset(SampleTypeRequest);
+    }
+    if(device->mSampleRate != req.mSampleRate && device->Flags.test(FrequencyRequest))
+    {
+        WARN("Failed to set {}hz, got {}hz instead", req.mSampleRate, device->mSampleRate);
+        device->Flags.reset(FrequencyRequest);
+    }
+
+    TRACE("Post-reset: {}, {}, {}hz, {} / {} buffer",
+        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
+        device->mSampleRate, device->mUpdateSize, device->mBufferSize);
+    return true;
+}
+
 /**
  * Updates device parameters according to the attribute list (caller is
  * responsible for holding the list lock).
@@ -1086,6 +1445,12 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
         return ALC_INVALID_VALUE;
     }
 
+    /* Remember the current renderer state, to see what needs to be updated
+     * after the reset.
+     */
+    const auto wasPrepared = device->mDeviceState != DeviceState::Unprepared;
+    const auto oldRenderer = RendererState{device};
+
     uint numMono{device->NumMonoSources};
     uint numStereo{device->NumStereoSources};
     uint numSends{device->NumAuxSends};
@@ -1329,6 +1694,14 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
                 /* Handled in alcCreateContext */
                 break;
 
+            case ATTRIBUTE(ALC_PREALLOC_VOICES_SOFT)
+                /* Handled in alcCreateContext */
+                break;
+
+            case ATTRIBUTE(ALC_PREALLOC_EFFECT_SLOTS_SOFT)
+                /* Handled in alcCreateContext */
+                break;
+
             case ATTRIBUTE(ALC_SYNC)
                 /* Ignored attribute */
                 break;
@@ -1432,17 +1805,86 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
                 optsrate = static_cast<uint>(freqAttr);
             }
         }
+    }
 
+    auto fmtreq = al::Device::FormatRequest{};
+    if(device->Type == DeviceType::Loopback)
+    {
+        fmtreq.mSampleRate = *optsrate;
+        fmtreq.mUpdateSize = device->mUpdateSize;
+        fmtreq.mBufferSize = device->mBufferSize;
+        fmtreq.mChannels = *optchans;
+        fmtreq.mType = *opttype;
+        if(fmtreq.mChannels == DevFmtAmbi3D)
+        {
+            fmtreq.mAmbiOrder = aorder;
+            fmtreq.mAmbiLayout = *optlayout;
+            fmtreq.mAmbiScale = *optscale;
+        }
+        fmtreq.mFrequencyRequest = true;
+        fmtreq.mChannelsRequest = true;
+        fmtreq.mSampleTypeRequest = true;
+    }
+    else
+    {
+        fmtreq.mSampleRate = optsrate.value_or(DefaultOutputRate);
+        fmtreq.mUpdateSize = period_size;
+        fmtreq.mBufferSize = buffer_size;
+        fmtreq.mChannels = optchans.value_or(DevFmtChannelsDefault);
+        fmtreq.mType = opttype.value_or(DevFmtTypeDefault);
+        fmtreq.mFrequencyRequest = optsrate.has_value();
+        fmtreq.mChannelsRequest = optchans.has_value();
+        fmtreq.mSampleTypeRequest = opttype.has_value();
+
+        if(fmtreq.mChannels == DevFmtAmbi3D)
+        {
+            fmtreq.mAmbiOrder = std::clamp(aorder, 1u, uint{MaxAmbiOrder});
+            fmtreq.mAmbiLayout = optlayout.value_or(DevAmbiLayout::Default);
+            fmtreq.mAmbiScale = optscale.value_or(DevAmbiScaling::Default);
+            if(fmtreq.mAmbiOrder > 3
+                && (fmtreq.mAmbiLayout == DevAmbiLayout::FuMa
+                    || fmtreq.mAmbiScale == DevAmbiScaling::FuMa))
+            {
+                ERR("FuMa is incompatible with {}{} order ambisonics (up to 3rd order only)",
+                    fmtreq.mAmbiOrder, GetCounterSuffix(fmtreq.mAmbiOrder));
+                fmtreq.mAmbiOrder = 3;
+            }
+        }
+    }
+
+    /* Set if the backend is kept running, with the output held while the
+     * renderer is updated.
+     */
+    auto holdOutput = false;
+    auto wasPlaying = false;
+    if(!attrList.empty())
+    {
         /* If a context is already running on the device, stop playback so the
-         * device attributes can be updated.
+         * device attributes can be updated. If the backend format isn't
+         * changing, only the output needs to be held while the renderer gets
+         * updated.
          */
         if(device->mDeviceState == DeviceState::Playing)
         {
-            device->Backend->stop();
+            if(device->Type != DeviceType::Loopback && fmtreq == device->mLastFormatRequest)
+                holdOutput = HoldDeviceOutput(device);
+            if(!holdOutput)
+            {
+                device->Backend->stop();
+                device->mOutputHold.store(DeviceBase::OutputHold::None,
+                    std::memory_order_relaxed);
+            }
             device->mDeviceState = DeviceState::Unprepared;
+            wasPlaying = true;
+
+            /* The mixer may have disconnected while a hold was requested. */
+            if(!holdOutput && device->handlePendingDisconnect())
+                return ALC_INVALID_DEVICE;
         }
 
-        UpdateClockBase(device);
+        /* A held output keeps the mixer advancing the clock. */
+        if(!holdOutput)
+            UpdateClockBase(device);
     }
 
     if(device->mDeviceState == DeviceState::Playing)
@@ -1465,12 +1907,16 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
     device->Dry.Buffer = {};
     std::fill(std::begin(device->NumChannelsPerOrder), std::end(device->NumChannelsPerOrder), 0u);
     device->RealOut.RemixMap = {};
-    device->RealOut.ChannelIndex.fill(InvalidChannelIndex);
+    /* The channel indices are set by the backend, so keep them when the
+     * backend isn't being reset.
+     */
+    if(!holdOutput)
+        device->RealOut.ChannelIndex.fill(InvalidChannelIndex);
     device->RealOut.Buffer = {};
     device->MixBuffer.clear();
-    device->MixBuffer.shrink_to_fit();
 
-    UpdateClockBase(device);
+    if(!holdOutput)
+        UpdateClockBase(device);
     device->FixedLatency = nanoseconds::zero();
 
     device->DitherDepth = 0.0f;
@@ -1482,89 +1928,20 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
      * Update device format request
      */
 
-    if(device->Type == DeviceType::Loopback)
-    {
-        device->mSampleRate = *optsrate;
-        device->FmtChans = *optchans;
-        device->FmtType = *opttype;
-        if(device->FmtChans == DevFmtAmbi3D)
-        {
-            device->mAmbiOrder = aorder;
-            device->mAmbiLayout = *optlayout;
-            device->mAmbiScale = *optscale;
-        }
-        device->Flags.set(FrequencyRequest).set(ChannelsRequest).set(SampleTypeRequest);
-    }
+    if(holdOutput)
+        TRACE("Keeping backend format: {}, {}, {}hz, {} / {} buffer",
+            DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
+            device->mSampleRate, device->mUpdateSize, device->mBufferSize);
     else
     {
-        device->FmtType = opttype.value_or(DevFmtTypeDefault);
-        device->FmtChans = optchans.value_or(DevFmtChannelsDefault);
-        device->mAmbiOrder = 0;
-        device->mBufferSize = buffer_size;
-        device->mUpdateSize = period_size;
-        device->mSampleRate = optsrate.value_or(DefaultOutputRate);
-        device->Flags.set(FrequencyRequest, optsrate.has_value())
-            .set(ChannelsRequest, optchans.has_value())
-            .set(SampleTypeRequest, opttype.has_value());
-
-        if(device->FmtChans == DevFmtAmbi3D)
-        {
-            device->mAmbiOrder = std::clamp(aorder, 1u, uint{MaxAmbiOrder});
-            device->mAmbiLayout = optlayout.value_or(DevAmbiLayout::Default);
-            device->mAmbiScale = optscale.value_or(DevAmbiScaling::Default);
-            if(device->mAmbiOrder > 3
-                && (device->mAmbiLayout == DevAmbiLayout::FuMa
-                    || device->mAmbiScale == DevAmbiScaling::FuMa))
-            {
-                ERR("FuMa is incompatible with {}{} order ambisonics (up to 3rd order only)",
-                    device->mAmbiOrder, GetCounterSuffix(device->mAmbiOrder));
-                device->mAmbiOrder = 3;
-            }
+        if(!ResetBackendFormat(device, fmtreq))
+        {
+            device->mLastFormatRequest.reset();
+            return ALC_INVALID_DEVICE;
         }
+        device->mLastFormatRequest = fmtreq;
     }
 
-    TRACE("Pre-reset: {}{}, {}{}, {}{}hz, {} / {} buffer",
-        device->Flags.test(ChannelsRequest)?"*":"", DevFmtChannelsString(device->FmtChans),
-        device->Flags.test(SampleTypeRequest)?"*":"", DevFmtTypeString(device->FmtType),
-        device->Flags.test(FrequencyRequest)?"*":"", device->mSampleRate,
-        device->mUpdateSize, device->mBufferSize);
-
-    const uint oldFreq{device->mSampleRate};
-    const DevFmtChannels oldChans{device->FmtChans};
-    const DevFmtType oldType{device->FmtType};
-    try {
-        auto backend = device->Backend.get();
-        if(!backend->reset())
-            throw al::backend_exception{al::backend_error::DeviceError, "Device reset failure"};
-    }
-    catch(std::exception &e) {
-        ERR("Device error: {}", e.what());
-        device->handleDisconnect("{}", e.what());
-        return ALC_INVALID_DEVICE;
-    }
-
-    if(device->FmtChans != oldChans && device->Flags.test(ChannelsRequest))
-    {
-        ERR("Failed to set {}, got {} instead", DevFmtChannelsString(oldChans),
-            DevFmtChannelsString(device->FmtChans));
-        device->Flags.reset(ChannelsRequest);
-    }
-    if(device->FmtType != oldType && device->Flags.test(SampleTypeRequest))
-    {
-        ERR("Failed to set {}, got {} instead", DevFmtTypeString(oldType),
-            DevFmtTypeString(device->FmtType));
-        device->Flags.reset(SampleTypeRequest);
-    }
-    if(device->mSampleRate != oldFreq && device->Flags.test(FrequencyRequest))
-    {
-        WARN("Failed to set {}hz, got {}hz instead", oldFreq, device->mSampleRate);
-        device->Flags.reset(FrequencyRequest);
-    }
-
-    TRACE("Post-reset: {}, {}, {}hz, {} / {} buffer",
-        DevFmtChannelsString(device->FmtChans), DevFmtTypeString(device->FmtType),
-        device->mSampleRate, device->mUpdateSize, device->mBufferSize);
-
     if(device->Type != DeviceType::Loopback)
     {
         if(auto modeopt = device->configValue<std::string>({}, "stereo-mode"))
@@ -1721,8 +2098,17 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
     device->FixedLatency += nanoseconds{seconds{sample_delay}} / device->mSampleRate;
     TRACE("Fixed device latency: {}ns", device->FixedLatency.count());
 
+    /* If the renderer state voices and effects were prepared with didn't
+     * change, they can continue as they were.
+     */
+    const auto newRenderer = RendererState{device};
+    const auto keepVoices = wasPrepared && oldRenderer == newRenderer;
+    const auto keepEffects = wasPrepared && oldRenderer.mEffect == newRenderer.mEffect;
+    TRACE("Renderer reset: {} voices, {} effects", keepVoices ? "keeping" : "preparing",
+        keepEffects ? "keeping" : "updating");
+
     FPUCtl mixer_mode{};
-    auto reset_context = [device](ContextBase *ctxbase)
+    auto reset_context = [device,keepVoices,keepEffects](ContextBase *ctxbase)
     {
         auto *context = dynamic_cast<ALCcontext*>(ctxbase);
         assert(context != nullptr);
@@ -1741,15 +2127,15 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
             context->mEffectSlotClusters.end(), slot_cluster_not_in_use);
         context->mEffectSlotClusters.erase(slotcluster_end, context->mEffectSlotClusters.end());
 
-        /* Free all wet buffers. Any in use will be reallocated with an updated
-         * configuration in aluInitEffectPanning.
+        /* Clear all wet buffers. Any in use will be resized with an updated
+         * configuration in aluInitEffectPanning, reusing the existing
+         * allocation when possible.
          */
         auto clear_wetbuffers = [](ContextBase::EffectSlotCluster &clusterptr)
         {
             auto clear_buffer = [](EffectSlot &slot)
             {
                 slot.mWetBuffer.clear();
-                slot.mWetBuffer.shrink_to_fit();
                 slot.Wet.Buffer = {};
             };
             std::for_each(clusterptr->begin(), clusterptr->end(), clear_buffer);
@@ -1767,13 +2153,14 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
 
             EffectState *state{slot->Effect.State.get()};
             state->mOutTarget = device->Dry.Buffer;
-            state->deviceUpdate(device, slot->Buffer);
+            if(!keepEffects)
+                state->deviceUpdate(device, slot->Buffer);
             slot->mPropsDirty = true;
         }
 
         if(EffectSlotArray *curarray{context->mActiveAuxSlots.load(std::memory_order_relaxed)})
             std::fill(curarray->begin()+ptrdiff_t(curarray->size()>>1), curarray->end(), nullptr);
-        auto reset_slots = [device,context](EffectSlotSubList &sublist)
+        auto reset_slots = [device,context,keepEffects](EffectSlotSubList &sublist)
         {
             uint64_t usemask{~sublist.FreeMask};
             while(usemask)
@@ -1790,7 +2177,8 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
 
                 EffectState *state{slot.Effect.State.get()};
                 state->mOutTarget = device->Dry.Buffer;
-                state->deviceUpdate(device, slot.Buffer);
+                if(!keepEffects)
+                    state->deviceUpdate(device, slot.Buffer);
                 slot.mPropsDirty = true;
             }
         };
@@ -1800,6 +2188,7 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
         /* Clear all effect slot props to let them get allocated again. */
         context->mEffectSlotPropClusters.clear();
         context->mFreeEffectSlotProps.store(nullptr, std::memory_order_relaxed);
+        context->preallocEffectSlots();
         slotlock.unlock();
 
         std::unique_lock<std::mutex> srclock{context->mSourceLock};
@@ -1832,7 +2221,7 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
         };
         std::for_each(context->mSourceList.begin(), context->mSourceList.end(), reset_sources);
 
-        auto reset_voice = [device,num_sends,context](Voice *voice)
+        auto reset_voice = [device,num_sends,context,keepVoices](Voice *voice)
         {
             /* Clear extraneous property set sends. */
             const auto sendparams = std::span{voice->mProps.Send}.subspan(num_sends);
@@ -1853,7 +2242,7 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
             Voice::State vstate{Voice::Stopping};
             voice->mPlayState.compare_exchange_strong(vstate, Voice::Stopped,
                 std::memory_order_acquire, std::memory_order_acquire);
-            if(voice->mSourceID.load(std::memory_order_relaxed) == 0u)
+            if(voice->mSourceID.load(std::memory_order_relaxed) == 0u || keepVoices)
                 return;
 
             voice->prepare(device);
@@ -1864,6 +2253,7 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
         /* Clear all voice props to let them get allocated again. */
         context->mVoicePropClusters.clear();
         context->mFreeVoiceProps.store(nullptr, std::memory_order_relaxed);
+        context->preallocVoices();
         srclock.unlock();
 
         context->mPropsDirty = false;
@@ -1876,8 +2266,32 @@ auto UpdateDeviceParams(al::Device *device, const std::span<const int> attrList)
     mixer_mode.leave();
 
     device->mDeviceState = DeviceState::Configured;
-    if(!device->Flags.test(DevicePaused))
+    if(holdOutput)
     {
+        /* The backend is still running, so release the output for the mixer
+         * to fade back in.
+         */
+        device->mOutputHold.store(DeviceBase::OutputHold::Releasing, std::memory_order_release);
+        if(device->mDisconnectPending.load(std::memory_order_acquire)) [[unlikely]]
+        {
+            /* The mixer reported a disconnect while the renderer was being
+             * updated. Stop it so the disconnect can be handled.
+             */
+            device->Backend->stop();
+            device->handlePendingDisconnect();
+            return ALC_INVALID_DEVICE;
+        }
+        device->mDeviceState = DeviceState::Playing;
+        TRACE("Updated renderer with the output held, without restarting the backend");
+    }
+    else if(!device->Flags.test(DevicePaused))
+    {
+        /* Fade the output in if playback is being restarted with voices that
+         * were already playing.
+         */
+        if(wasPlaying)
+            device->mOutputHold.store(DeviceBase::OutputHold::Releasing,
+                std::memory_order_relaxed);
         try {
             auto backend = device->Backend.get();
             backend->start();
@@ -1930,8 +2344,11 @@ auto ResetDeviceParams(al::Device *device, const std::span<const int> attrList)
             ctx->mVoiceClusters.clear();
             ctx->allocVoices(std::max<size_t>(256,
                 ctx->mActiveVoiceCount.load(std::memory_order_relaxed)));
+            ctx->preallocVoices();
         }
 
+        /* Force the backend to reset, rather than trying to keep it running. */
+        device->mLastFormatRequest.reset();
         device->Connected.store(true);
     }
 
@@ -2175,6 +2592,15 @@ ALC_API auto ALC_APIENTRY alcGetString(ALCdevice *Device, ALCenum param) noexcep
 }
 
 namespace {
+/* Gets the number of captured samples the app can read, including any held in
+ * the staging buffer for alcCaptureAcquireSamplesSOFT.
+ */
+auto AvailableCaptureSamples(al::Device *device) -> uint
+{
+    const auto staged = device->mCaptureStaging.size() / device->frameSizeFromFmt();
+    return static_cast<uint>(staged) + device->Backend->availableSamples();
+}
+
 auto GetIntegerv(al::Device *device, ALCenum param, const std::span<int> values) -> size_t
 {
     if(values.empty())
@@ -2245,7 +2671,7 @@ auto GetIntegerv(al::Device *device, ALCenum param, const std::span<int> values)
                 values[i++] = ALC_MINOR_VERSION;
                 values[i++] = alcMinorVersion;
                 values[i++] = ALC_CAPTURE_SAMPLES;
-                values[i++] = static_cast<int>(device->Backend->availableSamples());
+                values[i++] = static_cast<int>(AvailableCaptureSamples(device));
                 values[i++] = ALC_CONNECTED;
                 values[i++] = device->Connected.load(std::memory_order_relaxed);
                 values[i++] = 0;
@@ -2263,7 +2689,7 @@ auto GetIntegerv(al::Device *device, ALCenum param, const std::span<int> values)
             return 1;
 
         case ALC_CAPTURE_SAMPLES:
-            values[0] = static_cast<int>(device->Backend->availableSamples());
+            values[0] = static_cast<int>(AvailableCaptureSamples(device));
             return 1;
 
         case ALC_CONNECTED:
@@ -2761,12 +3187,21 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
     }
 
     ContextFlagBitset ctxflags{0};
-    for(size_t i{0};i < attrSpan.size();i+=2)
+    uint prealloc_voices{0u}, prealloc_slots{0u};
+    for(size_t i{0};i+1 < attrSpan.size();i+=2)
     {
-        if(attrSpan[i] == ALC_CONTEXT_FLAGS_EXT)
+        switch(attrSpan[i])
         {
+        case ALC_CONTEXT_FLAGS_EXT:
             ctxflags = static_cast<ALuint>(attrSpan[i+1]);
             break;
+        case ALC_PREALLOC_VOICES_SOFT:
+            prealloc_voices = static_cast<uint>(std::clamp(attrSpan[i+1], 0, MaxPreallocVoices));
+            break;
+        case ALC_PREALLOC_EFFECT_SLOTS_SOFT:
+            prealloc_slots = static_cast<uint>(std::max(attrSpan[i+1], 0));
+            prealloc_slots = std::min(prealloc_slots, dev->AuxiliaryEffectSlotMax);
+            break;
         }
     }
 
@@ -2776,6 +3211,8 @@ ALC_API ALCcontext* ALC_APIENTRY alcCreateContext(ALCdevice *device, const ALCin
         alcSetError(dev.get(), ALC_OUT_OF_MEMORY);
         return nullptr;
     }
+    context->mPreallocVoices = prealloc_voices;
+    context->mPreallocEffectSlots = prealloc_slots;
     context->init();
 
     if(auto volopt = dev->configValue<float>({}, "volume-adjust"))
@@ -2953,7 +3390,7 @@ ALC_API ALCdevice* ALC_APIENTRY alcGetContextsDevice(ALCcontext *Context) noexce
 
 ALC_API ALCdevice* ALC_APIENTRY alcOpenDevice(const ALCchar *deviceName) noexcept
 {
-    InitConfig();
+    InitBackends();
 
     if(!PlaybackFactory)
     {
@@ -3127,7 +3564,7 @@ ALC_API ALCboolean ALC_APIENTRY alcCloseDevice(ALCdevice *device) noexcept
  ************************************************/
 ALC_API ALCdevice* ALC_APIENTRY alcCaptureOpenDevice(const ALCchar *deviceName, ALCuint frequency, ALCenum format, ALCsizei samples) noexcept
 {
-    InitConfig();
+    InitBackends();
 
     if(!CaptureFactory)
     {
@@ -3261,6 +3698,7 @@ ALC_API void ALC_APIENTRY alcCaptureStart(ALCdevice *device) noexcept
     {
         try {
             auto backend = dev->Backend.get();
+            dev->mCaptureStaging.clear();
             backend->start();
             dev->mDeviceState = DeviceState::Playing;
         }
@@ -3283,6 +3721,7 @@ ALC_API void ALC_APIENTRY alcCaptureStop(ALCdevice *device) noexcept
         if(dev->mDeviceState == DeviceState::Playing)
         {
             dev->Backend->stop();
+            dev->mCaptureStaging.clear();
             dev->mDeviceState = DeviceState::Configured;
         }
     }
@@ -3308,14 +3747,123 @@ ALC_API void ALC_APIENTRY alcCaptureSamples(ALCdevice *device, ALCvoid *buffer,
     std::lock_guard<std::mutex> statelock{dev->StateLock};
     BackendBase *backend{dev->Backend.get()};
 
-    const auto usamples = static_cast<uint>(samples);
-    if(usamples > backend->availableSamples())
+    auto usamples = static_cast<uint>(samples);
+    if(usamples > AvailableCaptureSamples(dev.get()))
+    {
+        alcSetError(dev.get(), ALC_INVALID_VALUE);
+        return;
+    }
+
+    auto *dst = static_cast<std::byte*>(buffer);
+    if(!dev->mCaptureStaging.empty())
+    {
+        /* Samples left over from alcCaptureAcquireSamplesSOFT come first. */
+        const auto frameSize = size_t{dev->frameSizeFromFmt()};
+        const auto staged = std::min(size_t{usamples}*frameSize, dev->mCaptureStaging.size());
+        dst = std::copy_n(dev->mCaptureStaging.begin(), staged, dst);
+        dev->mCaptureStaging.erase(dev->mCaptureStaging.begin(),
+            dev->mCaptureStaging.begin()+static_cast<ptrdiff_t>(staged));
+        usamples -= static_cast<uint>(staged / frameSize);
+        if(usamples == 0)
+            return;
+    }
+    backend->captureSamples(dst, usamples);
+}
+
+/** Gets a read-only view of the captured samples, without copying them out. */
+ALC_API void ALC_APIENTRY alcCaptureAcquireSamplesSOFT(ALCdevice *device, const ALCvoid **data1,
+    ALCsizei *samples1, const ALCvoid **data2, ALCsizei *samples2) noexcept
+{
+    DeviceRef dev{VerifyDevice(device)};
+    if(!dev || dev->Type != DeviceType::Capture)
+    {
+        alcSetError(dev.get(), ALC_INVALID_DEVICE);
+        return;
+    }
+    if(!data1 || !samples1 || !data2 || !samples2)
     {
         alcSetError(dev.get(), ALC_INVALID_VALUE);
         return;
     }
 
-    backend->captureSamples(static_cast<std::byte*>(buffer), usamples);
+    std::lock_guard<std::mutex> statelock{dev->StateLock};
+    BackendBase *backend{dev->Backend.get()};
+
+    if(RingBuffer *ring{backend->getCaptureRing()})
+    {
+        /* Let the backend move any pending samples into the ring first. The
+         * samples are then handed out in place, and only become writable for
+         * the backend again once they're released.
+         */
+        std::ignore = backend->availableSamples();
+        auto vec = ring->getReadVector();
+        *data1 = vec[0].len ? vec[0].buf : nullptr;
+        *samples1 = static_cast<ALCsizei>(vec[0].len);
+        *data2 = vec[1].len ? vec[1].buf : nullptr;
+        *samples2 = static_cast<ALCsizei>(vec[1].len);
+        return;
+    }
+
+    /* Otherwise pull what's available into the staging buffer, appending to
+     * any samples that haven't been released yet. The staging buffer holds no
+     * more than the device's buffer size, leaving the rest with the backend
+     * until the app releases some.
+     */
+    const auto frameSize = size_t{dev->frameSizeFromFmt()};
+    const auto staged = dev->mCaptureStaging.size();
+    const auto stagedFrames = static_cast<uint>(staged / frameSize);
+    const auto avail = std::min(backend->availableSamples(),
+        dev->mBufferSize - std::min(stagedFrames, dev->mBufferSize));
+    if(avail > 0)
+    {
+        dev->mCaptureStaging.resize(staged + size_t{avail}*frameSize);
+        backend->captureSamples(std::to_address(dev->mCaptureStaging.begin()+
+            static_cast<ptrdiff_t>(staged)), avail);
+    }
+    *data1 = dev->mCaptureStaging.empty() ? nullptr : dev->mCaptureStaging.data();
+    *samples1 = static_cast<ALCsizei>(dev->mCaptureStaging.size() / frameSize);
+    *data2 = nullptr;
+    *samples2 = 0;
+}
+
+/** Releases samples from the front of the view given by alcCaptureAcquireSamplesSOFT. */
+ALC_API void ALC_APIENTRY alcCaptureReleaseSamplesSOFT(ALCdevice *device, ALCsizei samples) noexcept
+{
+    DeviceRef dev{VerifyDevice(device)};
+    if(!dev || dev->Type != DeviceType::Capture)
+    {
+        alcSetError(dev.get(), ALC_INVALID_DEVICE);
+        return;
+    }
+    if(samples < 0)
+    {
+        alcSetError(dev.get(), ALC_INVALID_VALUE);
+        return;
+    }
+    if(samples < 1)
+        return;
+
+    std::lock_guard<std::mutex> statelock{dev->StateLock};
+    const auto usamples = static_cast<uint>(samples);
+    if(RingBuffer *ring{dev->Backend->getCaptureRing()})
+    {
+        if(usamples > ring->readSpace())
+        {
+            alcSetError(dev.get(), ALC_INVALID_VALUE);
+            return;
+        }
+        ring->readAdvance(usamples);
+        return;
+    }
+
+    const auto count = size_t{usamples} * dev->frameSizeFromFmt();
+    if(count > dev->mCaptureStaging.size())
+    {
+        alcSetError(dev.get(), ALC_INVALID_VALUE);
+        return;
+    }
+    dev->mCaptureStaging.erase(dev->mCaptureStaging.begin(),
+        dev->mCaptureStaging.begin()+static_cast<ptrdiff_t>(count));
 }
 
 
@@ -3540,15 +4088,19 @@ ALC_API ALCboolean ALC_APIENTRY alcResetDeviceSOFT(ALCdevice *device, const ALCi
     listlock.unlock();
 
     /* Force the backend to stop mixing first since we're resetting. Also reset
-     * the connected state so lost devices can attempt recover.
+     * the connected state so lost devices can attempt recover. A connected
+     * device given attributes is left for UpdateDeviceParams to stop, in case
+     * the backend can keep running.
      */
-    if(dev->mDeviceState == DeviceState::Playing)
+    const auto attrSpan = SpanFromAttributeList(attribs);
+    if(dev->mDeviceState == DeviceState::Playing
+        && (attrSpan.empty() || !dev->Connected.load(std::memory_order_relaxed)))
     {
         dev->Backend->stop();
         dev->mDeviceState = DeviceState::Configured;
     }
 
-    return ResetDeviceParams(dev.get(), SpanFromAttributeList(attribs)) ? ALC_TRUE : ALC_FALSE;
+    return ResetDeviceParams(dev.get(), attrSpan) ? ALC_TRUE : ALC_FALSE;
 }
 
 
@@ -3684,6 +4236,8 @@ FORCE_ALIGN ALCenum ALC_APIENTRY alcEventIsSupportedSOFT(ALCenum eventType, ALCe
         return ALC_FALSE;
     }
 
+    InitBackends();
+
     auto supported = alc::EventSupport::NoSupport;
     switch(deviceType)
     {
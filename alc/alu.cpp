@@ -33,6 +33,7 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <limits>
@@ -42,9 +43,16 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <utility>
 #include <variant>
 
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "alnumeric.h"
 #include "alstring.h"
 #include "atomic.h"
@@ -1220,8 +1228,8 @@ void CalcPanningAndFilters(Voice *voice, const float xpos, const float ypos, con
                 const float src_ev{std::asin(std::clamp(ypos, -1.0f, 1.0f))};
                 const float src_az{std::atan2(xpos, -zpos)};
 
-                Device->mHrtf->getCoeffs(src_ev, src_az, Distance*NfcScale, Spread,
-                    voice->mChans[0].mDryParams.Hrtf.Target.Coeffs,
+                Device->mHrtfCache->getCoeffs(*Device->mHrtf, src_ev, src_az, Distance*NfcScale,
+                    Spread, voice->mChans[0].mDryParams.Hrtf.Target.Coeffs,
                     voice->mChans[0].mDryParams.Hrtf.Target.Delay);
                 voice->mChans[0].mDryParams.Hrtf.Target.Gain = DryGain.Base;
 
@@ -1260,7 +1268,7 @@ void CalcPanningAndFilters(Voice *voice, const float xpos, const float ypos, con
                 const float ev{std::asin(std::clamp(pos[1], -1.0f, 1.0f))};
                 const float az{std::atan2(pos[0], -pos[2])};
 
-                Device->mHrtf->getCoeffs(ev, az, Distance*NfcScale, 0.0f,
+                Device->mHrtfCache->getCoeffs(*Device->mHrtf, ev, az, Distance*NfcScale, 0.0f,
                     voice->mChans[c].mDryParams.Hrtf.Target.Coeffs,
                     voice->mChans[c].mDryParams.Hrtf.Target.Delay);
                 voice->mChans[c].mDryParams.Hrtf.Target.Gain = DryGain.Base * pangain;
@@ -1299,7 +1307,8 @@ void CalcPanningAndFilters(Voice *voice, const float xpos, const float ypos, con
                 const float ev{std::asin(chans[c].pos[1])};
                 const float az{std::atan2(chans[c].pos[0], -chans[c].pos[2])};
 
-                Device->mHrtf->getCoeffs(ev, az, std::numeric_limits<float>::infinity(), spread,
+                Device->mHrtfCache->getCoeffs(*Device->mHrtf, ev, az,
+                    std::numeric_limits<float>::infinity(), spread,
                     voice->mChans[c].mDryParams.Hrtf.Target.Coeffs,
                     voice->mChans[c].mDryParams.Hrtf.Target.Delay);
                 voice->mChans[c].mDryParams.Hrtf.Target.Gain = DryGain.Base * pangain;
@@ -2161,29 +2170,49 @@ void ApplyDistanceComp(const std::span<FloatBufferLine> Samples, const size_t Sa
     }
 }
 
-void ApplyDither(const std::span<FloatBufferLine> Samples, uint *dither_seed,
-    const float quant_scale, const size_t SamplesToDo)
+/* Returns the multiplier and increment that advance the dither RNG by the
+ * given number of steps at once.
+ */
+constexpr auto dither_rng_step(size_t count) noexcept -> std::array<uint,2>
+{
+    auto mul = uint{96314165u};
+    auto add = uint{907633515u};
+    auto accmul = uint{1u};
+    auto accadd = uint{0u};
+    while(count)
+    {
+        if((count&1))
+        {
+            accmul *= mul;
+            accadd = accadd*mul + add;
+        }
+        add = (mul+1u) * add;
+        mul *= mul;
+        count >>= 1;
+    }
+    return {accmul, accadd};
+}
+
+inline auto dither_rng_skip(const uint seed, const size_t count) noexcept -> uint
+{
+    const auto [mul, add] = dither_rng_step(count);
+    return seed*mul + add;
+}
+
+/* Dithering. Generate whitenoise (uniform distribution of random values
+ * between -1 and +1) and add it to the sample value, after scaling up to the
+ * desired quantization depth and before rounding.
+ */
+inline auto dither_sample(const float sample, uint *seed, const float quant_scale,
+    const float invscale) noexcept -> float
 {
     static constexpr double invRNGRange{1.0 / std::numeric_limits<uint>::max()};
-    ASSUME(SamplesToDo > 0);
 
-    /* Dithering. Generate whitenoise (uniform distribution of random values
-     * between -1 and +1) and add it to the sample values, after scaling up to
-     * the desired quantization depth and before rounding.
-     */
-    const float invscale{1.0f / quant_scale};
-    uint seed{*dither_seed};
-    auto dither_sample = [&seed,invscale,quant_scale](const float sample) noexcept -> float
-    {
-        float val{sample * quant_scale};
-        uint rng0{dither_rng(&seed)};
-        uint rng1{dither_rng(&seed)};
-        val += static_cast<float>(rng0*invRNGRange - rng1*invRNGRange);
-        return fast_roundf(val) * invscale;
-    };
-    for(FloatBufferLine &inout : Samples)
-        std::transform(inout.begin(), inout.begin()+SamplesToDo, inout.begin(), dither_sample);
-    *dither_seed = seed;
+    float val{sample * quant_scale};
+    uint rng0{dither_rng(seed)};
+    uint rng1{dither_rng(seed)};
+    val += static_cast<float>(rng0*invRNGRange - rng1*invRNGRange);
+    return fast_roundf(val) * invscale;
 }
 
 
@@ -2217,9 +2246,308 @@ template<> inline uint16_t SampleConv(float val) noexcept
 template<> inline uint8_t SampleConv(float val) noexcept
 { return static_cast<uint8_t>(SampleConv<int8_t>(val) + 128); }
 
+/* Scale and clamp limits matching SampleConv, for the SIMD conversions. */
+template<typename T>
+struct SampleLimits {
+    using signed_type = std::make_signed_t<T>;
+    static constexpr float Scale{-static_cast<float>(std::numeric_limits<signed_type>::min())};
+    static constexpr float Min{static_cast<float>(std::numeric_limits<signed_type>::min())};
+    static constexpr float Max{sizeof(T) == 4 ? 2147483520.0f
+        : static_cast<float>(std::numeric_limits<signed_type>::max())};
+};
+
+
+#if HAVE_SSE_INTRINSICS
+
+/* SSE2 lacks _mm_mullo_epi32, so multiply the even and odd lanes separately. */
+inline auto MulLo4(const __m128i a, const __m128i b) noexcept -> __m128i
+{
+    const auto even = _mm_mul_epu32(a, b);
+    const auto odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+    return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0,0,2,0)),
+        _mm_shuffle_epi32(odd, _MM_SHUFFLE(0,0,2,0)));
+}
+
+/* Generates the dither noise for four consecutive samples at a time, giving
+ * the same values as dither_sample would with the same starting seed.
+ */
+class DitherGen4 {
+    static constexpr auto sStep = dither_rng_step(8);
+
+    __m128i mRng0{};
+    __m128i mRng1{};
+
+public:
+    explicit DitherGen4(uint seed) noexcept
+    {
+        auto rng = std::array<uint,8>{};
+        std::ranges::generate(rng, [&seed]() noexcept { return dither_rng(&seed); });
+        mRng0 = _mm_setr_epi32(static_cast<int>(rng[0]), static_cast<int>(rng[2]),
+            static_cast<int>(rng[4]), static_cast<int>(rng[6]));
+        mRng1 = _mm_setr_epi32(static_cast<int>(rng[1]), static_cast<int>(rng[3]),
+            static_cast<int>(rng[5]), static_cast<int>(rng[7]));
+    }
+
+    auto apply(const __m128 sample, const __m128 quant_scale, const __m128 invscale) noexcept
+        -> __m128
+    {
+        static constexpr double invRNGRange{1.0 / std::numeric_limits<uint>::max()};
+
+        /* Unsigned to double conversion, for the low two lanes. */
+        auto u2d = [](const __m128i v) noexcept -> __m128d
+        {
+            const auto s = _mm_xor_si128(v, _mm_set1_epi32(std::numeric_limits<int>::min()));
+            return _mm_add_pd(_mm_cvtepi32_pd(s), _mm_set1_pd(2147483648.0));
+        };
+        const auto inv = _mm_set1_pd(invRNGRange);
+        const auto nlo = _mm_sub_pd(_mm_mul_pd(u2d(mRng0), inv), _mm_mul_pd(u2d(mRng1), inv));
+        const auto nhi = _mm_sub_pd(_mm_mul_pd(u2d(_mm_srli_si128(mRng0, 8)), inv),
+            _mm_mul_pd(u2d(_mm_srli_si128(mRng1, 8)), inv));
+        const auto noise = _mm_movelh_ps(_mm_cvtpd_ps(nlo), _mm_cvtpd_ps(nhi));
+
+        const auto mul = _mm_set1_epi32(static_cast<int>(sStep[0]));
+        const auto add = _mm_set1_epi32(static_cast<int>(sStep[1]));
+        mRng0 = _mm_add_epi32(MulLo4(mRng0, mul), add);
+        mRng1 = _mm_add_epi32(MulLo4(mRng1, mul), add);
+
+        /* Round like fast_roundf, by adding and removing the integral limit
+         * with a matching sign.
+         */
+        const auto val = _mm_add_ps(_mm_mul_ps(sample, quant_scale), noise);
+        const auto signmask = _mm_set1_ps(-0.0f);
+        const auto ilim = _mm_or_ps(_mm_set1_ps(8388608.0f), _mm_and_ps(val, signmask));
+        const auto rounded = _mm_sub_ps(_mm_add_ps(val, ilim), ilim);
+        const auto integral = _mm_cmpge_ps(_mm_andnot_ps(signmask, val), _mm_set1_ps(8388608.0f));
+        return _mm_mul_ps(_mm_or_ps(_mm_and_ps(integral, val), _mm_andnot_ps(integral, rounded)),
+            invscale);
+    }
+};
+
+inline auto Load4(const float *src) noexcept -> __m128 { return _mm_loadu_ps(src); }
+inline auto Splat4(const float val) noexcept -> __m128 { return _mm_set1_ps(val); }
+inline auto High2(const __m128 val) noexcept -> __m128 { return _mm_movehl_ps(val, val); }
+
+inline void Transpose4(__m128 &r0, __m128 &r1, __m128 &r2, __m128 &r3) noexcept
+{ _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+/* Interleaves two channels, into the first two frames and the second two
+ * frames.
+ */
+inline void Interleave2(const __m128 a, const __m128 b, __m128 &f01, __m128 &f23) noexcept
+{
+    f01 = _mm_unpacklo_ps(a, b);
+    f23 = _mm_unpackhi_ps(a, b);
+}
+
+/* Converts four samples for output type T, as 32-bit integer lanes (or as
+ * float bits for float output).
+ */
+template<typename T>
+inline auto ConvSample4(const __m128 val) noexcept -> __m128i
+{
+    if constexpr(std::is_same_v<T,float>)
+        return _mm_castps_si128(val);
+    else
+    {
+        using limits = SampleLimits<T>;
+        const auto scaled = _mm_mul_ps(val, _mm_set1_ps(limits::Scale));
+        return _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(scaled, _mm_set1_ps(limits::Min)),
+            _mm_set1_ps(limits::Max)));
+    }
+}
+
+/* Narrows converted samples to the size of T, applying the unsigned offset. */
+template<typename T>
+inline auto Narrow4(const __m128i val) noexcept -> __m128i
+{
+    if constexpr(std::is_same_v<T,float> || std::is_same_v<T,int32_t>)
+        return val;
+    else if constexpr(std::is_same_v<T,uint32_t>)
+        return _mm_xor_si128(val, _mm_set1_epi32(std::numeric_limits<int>::min()));
+    else if constexpr(sizeof(T) == 2)
+    {
+        const auto packed = _mm_packs_epi32(val, val);
+        if constexpr(std::is_unsigned_v<T>)
+            return _mm_xor_si128(packed, _mm_set1_epi16(std::numeric_limits<int16_t>::min()));
+        else
+            return packed;
+    }
+    else
+    {
+        const auto packed = _mm_packs_epi16(_mm_packs_epi32(val, val), _mm_setzero_si128());
+        if constexpr(std::is_unsigned_v<T>)
+            return _mm_xor_si128(packed, _mm_set1_epi8(std::numeric_limits<int8_t>::min()));
+        else
+            return packed;
+    }
+}
+
+/* Stores the first count (2 or 4) samples. */
+template<typename T, size_t count>
+inline void StoreSamples(T *dst, const __m128 val) noexcept
+{
+    static_assert(count == 2 || count == 4);
+    const auto narrow = Narrow4<T>(ConvSample4<T>(val));
+    if constexpr(sizeof(T)*count == 16)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), narrow);
+    else if constexpr(sizeof(T)*count == 8)
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), narrow);
+    else
+    {
+        const auto bits = _mm_cvtsi128_si32(narrow);
+        std::memcpy(dst, &bits, sizeof(T)*count);
+    }
+}
+
+#elif HAVE_NEON
+
+/* Generates the dither noise for four consecutive samples at a time, using the
+ * same RNG sequence as dither_sample. The noise is calculated with single-
+ * precision here, so may differ slightly from the scalar version.
+ */
+class DitherGen4 {
+    static constexpr auto sStep = dither_rng_step(8);
+
+    uint32x4_t mRng0{};
+    uint32x4_t mRng1{};
+
+public:
+    explicit DitherGen4(uint seed) noexcept
+    {
+        auto rng = std::array<uint,8>{};
+        std::ranges::generate(rng, [&seed]() noexcept { return dither_rng(&seed); });
+        const auto rng0 = std::array{rng[0], rng[2], rng[4], rng[6]};
+        const auto rng1 = std::array{rng[1], rng[3], rng[5], rng[7]};
+        mRng0 = vld1q_u32(rng0.data());
+        mRng1 = vld1q_u32(rng1.data());
+    }
+
+    auto apply(const float32x4_t sample, const float32x4_t quant_scale,
+        const float32x4_t invscale) noexcept -> float32x4_t
+    {
+        static constexpr float invRNGRange{1.0f / static_cast<float>(std::numeric_limits<uint>::max())};
+
+        const auto noise = vmulq_n_f32(vsubq_f32(vcvtq_f32_u32(mRng0), vcvtq_f32_u32(mRng1)),
+            invRNGRange);
+
+        const auto mul = vdupq_n_u32(sStep[0]);
+        const auto add = vdupq_n_u32(sStep[1]);
+        mRng0 = vmlaq_u32(add, mRng0, mul);
+        mRng1 = vmlaq_u32(add, mRng1, mul);
+
+        const auto val = vmlaq_f32(noise, sample, quant_scale);
+        const auto signmask = vdupq_n_u32(0x80000000u);
+        const auto ilim = vreinterpretq_f32_u32(vorrq_u32(vdupq_n_u32(0x4b000000u),
+            vandq_u32(vreinterpretq_u32_f32(val), signmask)));
+        const auto rounded = vsubq_f32(vaddq_f32(val, ilim), ilim);
+        const auto integral = vcageq_f32(val, vdupq_n_f32(8388608.0f));
+        return vmulq_f32(vbslq_f32(integral, val, rounded), invscale);
+    }
+};
+
+inline auto Load4(const float *src) noexcept -> float32x4_t { return vld1q_f32(src); }
+inline auto Splat4(const float val) noexcept -> float32x4_t { return vdupq_n_f32(val); }
+inline auto High2(const float32x4_t val) noexcept -> float32x4_t { return vextq_f32(val, val, 2); }
+
+inline void Transpose4(float32x4_t &r0, float32x4_t &r1, float32x4_t &r2, float32x4_t &r3) noexcept
+{
+    const auto t01 = vtrnq_f32(r0, r1);
+    const auto t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+inline void Interleave2(const float32x4_t a, const float32x4_t b, float32x4_t &f01,
+    float32x4_t &f23) noexcept
+{
+    const auto ab = vzipq_f32(a, b);
+    f01 = ab.val[0];
+    f23 = ab.val[1];
+}
+
+/* Converts four samples for output type T, as 32-bit integer lanes (or as
+ * float bits for float output). This truncates, same as fastf2i does here.
+ */
+template<typename T>
+inline auto ConvSample4(const float32x4_t val) noexcept -> int32x4_t
+{
+    if constexpr(std::is_same_v<T,float>)
+        return vreinterpretq_s32_f32(val);
+    else
+    {
+        using limits = SampleLimits<T>;
+        const auto scaled = vmulq_n_f32(val, limits::Scale);
+        return vcvtq_s32_f32(vminq_f32(vmaxq_f32(scaled, vdupq_n_f32(limits::Min)),
+            vdupq_n_f32(limits::Max)));
+    }
+}
+
+template<typename T, size_t count>
+inline void StoreSamples(T *dst, const float32x4_t val) noexcept
+{
+    static_assert(count == 2 || count == 4);
+    const auto conv = ConvSample4<T>(val);
+    if constexpr(sizeof(T) == 4)
+    {
+        auto bits = vreinterpretq_u32_s32(conv);
+        if constexpr(std::is_same_v<T,uint32_t>)
+            bits = veorq_u32(bits, vdupq_n_u32(0x80000000u));
+        if constexpr(count == 4)
+            vst1q_u32(reinterpret_cast<uint32_t*>(dst), bits);
+        else
+            vst1_u32(reinterpret_cast<uint32_t*>(dst), vget_low_u32(bits));
+    }
+    else if constexpr(sizeof(T) == 2)
+    {
+        auto bits = vreinterpret_u16_s16(vmovn_s32(conv));
+        if constexpr(std::is_unsigned_v<T>)
+            bits = veor_u16(bits, vdup_n_u16(0x8000u));
+        if constexpr(count == 4)
+            vst1_u16(reinterpret_cast<uint16_t*>(dst), bits);
+        else
+        {
+            const auto pair = vget_lane_u32(vreinterpret_u32_u16(bits), 0);
+            std::memcpy(dst, &pair, sizeof(pair));
+        }
+    }
+    else
+    {
+        const auto half = vmovn_s32(conv);
+        auto bits = vreinterpret_u8_s8(vmovn_s16(vcombine_s16(half, half)));
+        if constexpr(std::is_unsigned_v<T>)
+            bits = veor_u8(bits, vdup_n_u8(0x80u));
+        const auto quad = vget_lane_u32(vreinterpret_u32_u8(bits), 0);
+        std::memcpy(dst, &quad, sizeof(T)*count);
+    }
+}
+#endif
+
+/* Converts and writes one channel, from the given sample offset. */
+template<typename T>
+void WriteChannel(const std::span<const float> src, const std::span<T> output, const size_t offset,
+    const size_t FrameStep, const float quant_scale, uint seed)
+{
+    if(!(quant_scale > 0.0f))
+    {
+        for(size_t i{offset};i < src.size();++i)
+            output[i*FrameStep] = SampleConv<T>(src[i]);
+        return;
+    }
+
+    const auto invscale = 1.0f / quant_scale;
+    for(size_t i{offset};i < src.size();++i)
+        output[i*FrameStep] = SampleConv<T>(dither_sample(src[i], &seed, quant_scale, invscale));
+}
+
+/* Converts and interleaves the output channels. When dithering, each channel
+ * continues the RNG sequence from where the previous channel ends, as if the
+ * channels were dithered one after another.
+ */
 template<typename T>
 void Write(const std::span<const FloatBufferLine> InBuffer, void *OutBuffer, const size_t Offset,
-    const size_t SamplesToDo, const size_t FrameStep)
+    const size_t SamplesToDo, const size_t FrameStep, const float DitherDepth, uint *DitherSeed)
 {
     ASSUME(FrameStep > 0);
     ASSUME(SamplesToDo > 0);
@@ -2234,39 +2562,235 @@ void Write(const std::span<const FloatBufferLine> InBuffer, void *OutBuffer, con
     if(FrameStep > InBuffer.size())
         std::fill(output.begin(), output.end(), SampleConv<T>(0.0f));
 
-    auto outbase = output.begin();
-    for(const auto &srcbuf : InBuffer)
+    const auto dither = DitherDepth > 0.0f;
+    const auto seedstep = dither_rng_step(SamplesToDo*2);
+    auto seed = *DitherSeed;
+    auto next_seed = [&seed,seedstep]() noexcept -> uint
+    {
+        const auto ret = seed;
+        seed = seed*seedstep[0] + seedstep[1];
+        return ret;
+    };
+
+    auto chan = 0_uz;
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    const auto todo = SamplesToDo & ~3_uz;
+    const auto quant_scale = Splat4(DitherDepth);
+    const auto invscale = Splat4(1.0f / DitherDepth);
+
+    /* Transpose blocks of 4 channels by 4 frames, writing each frame's 4
+     * samples together.
+     */
+    for(;InBuffer.size()-chan >= 4;chan += 4)
     {
-        const auto src = std::span{srcbuf}.first(SamplesToDo);
-        auto out = outbase++;
+        const auto seeds = std::array{next_seed(), next_seed(), next_seed(), next_seed()};
+        auto gens = std::array{DitherGen4{seeds[0]}, DitherGen4{seeds[1]}, DitherGen4{seeds[2]},
+            DitherGen4{seeds[3]}};
+        const auto src = InBuffer.subspan(chan, 4);
+        const auto out = output.subspan(chan);
 
-        *out = SampleConv<T>(src.front());
-        std::for_each(src.begin()+1, src.end(), [FrameStep,&out](const float s) noexcept
+        for(size_t i{0};i < todo;i += 4)
         {
-            out += ptrdiff_t(FrameStep);
-            *out = SampleConv<T>(s);
-        });
+            auto s0 = Load4(&src[0][i]);
+            auto s1 = Load4(&src[1][i]);
+            auto s2 = Load4(&src[2][i]);
+            auto s3 = Load4(&src[3][i]);
+            if(dither)
+            {
+                s0 = gens[0].apply(s0, quant_scale, invscale);
+                s1 = gens[1].apply(s1, quant_scale, invscale);
+                s2 = gens[2].apply(s2, quant_scale, invscale);
+                s3 = gens[3].apply(s3, quant_scale, invscale);
+            }
+            Transpose4(s0, s1, s2, s3);
+            StoreSamples<T,4>(&out[i*FrameStep], s0);
+            StoreSamples<T,4>(&out[(i+1)*FrameStep], s1);
+            StoreSamples<T,4>(&out[(i+2)*FrameStep], s2);
+            StoreSamples<T,4>(&out[(i+3)*FrameStep], s3);
+        }
+        for(size_t c{0};c < 4;++c)
+            WriteChannel<T>(std::span{src[c]}.first(SamplesToDo), out.subspan(c), todo, FrameStep,
+                DitherDepth, dither_rng_skip(seeds[c], todo*2));
+    }
+
+    /* Interleave a remaining pair of channels, writing two frames' samples
+     * together (or all four, when the output is just the two channels).
+     */
+    if(InBuffer.size()-chan >= 2)
+    {
+        const auto seeds = std::array{next_seed(), next_seed()};
+        auto gens = std::array{DitherGen4{seeds[0]}, DitherGen4{seeds[1]}};
+        const auto src = InBuffer.subspan(chan, 2);
+        const auto out = output.subspan(chan);
+
+        for(size_t i{0};i < todo;i += 4)
+        {
+            auto s0 = Load4(&src[0][i]);
+            auto s1 = Load4(&src[1][i]);
+            if(dither)
+            {
+                s0 = gens[0].apply(s0, quant_scale, invscale);
+                s1 = gens[1].apply(s1, quant_scale, invscale);
+            }
+            auto f01 = s0;
+            auto f23 = s1;
+            Interleave2(s0, s1, f01, f23);
+            if(FrameStep == 2)
+            {
+                StoreSamples<T,4>(&out[i*2], f01);
+                StoreSamples<T,4>(&out[i*2 + 4], f23);
+            }
+            else
+            {
+                StoreSamples<T,2>(&out[i*FrameStep], f01);
+                StoreSamples<T,2>(&out[(i+1)*FrameStep], High2(f01));
+                StoreSamples<T,2>(&out[(i+2)*FrameStep], f23);
+                StoreSamples<T,2>(&out[(i+3)*FrameStep], High2(f23));
+            }
+        }
+        for(size_t c{0};c < 2;++c)
+            WriteChannel<T>(std::span{src[c]}.first(SamplesToDo), out.subspan(c), todo, FrameStep,
+                DitherDepth, dither_rng_skip(seeds[c], todo*2));
+        chan += 2;
+    }
+
+    /* A lone mono channel can be written directly. */
+    if(FrameStep == 1 && InBuffer.size()-chan == 1)
+    {
+        const auto chanseed = next_seed();
+        auto gen = DitherGen4{chanseed};
+        const auto src = std::span{InBuffer[chan]}.first(SamplesToDo);
+
+        for(size_t i{0};i < todo;i += 4)
+        {
+            auto s = Load4(&src[i]);
+            if(dither)
+                s = gen.apply(s, quant_scale, invscale);
+            StoreSamples<T,4>(&output[i], s);
+        }
+        WriteChannel<T>(src, output, todo, FrameStep, DitherDepth,
+            dither_rng_skip(chanseed, todo*2));
+        ++chan;
     }
+#endif
+
+    for(;chan < InBuffer.size();++chan)
+        WriteChannel<T>(std::span{InBuffer[chan]}.first(SamplesToDo), output.subspan(chan), 0,
+            FrameStep, DitherDepth, next_seed());
+
+    if(dither)
+        *DitherSeed = seed;
 }
 
 template<typename T>
 void Write(const std::span<const FloatBufferLine> InBuffer, std::span<void*> OutBuffers,
-    const size_t Offset, const size_t SamplesToDo)
+    const size_t Offset, const size_t SamplesToDo, const float DitherDepth, uint *DitherSeed)
 {
     ASSUME(SamplesToDo > 0);
 
+    const auto dither = DitherDepth > 0.0f;
+    auto seed = *DitherSeed;
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    const auto todo = SamplesToDo & ~3_uz;
+    const auto quant_scale = Splat4(DitherDepth);
+    const auto invscale = Splat4(1.0f / DitherDepth);
+#else
+    static constexpr auto todo = 0_uz;
+#endif
+
     auto srcbuf = InBuffer.begin();
     for(auto *dstbuf : OutBuffers)
     {
         const auto src = std::span{*srcbuf}.first(SamplesToDo);
         const auto dst = std::span{static_cast<T*>(dstbuf), Offset+SamplesToDo}.subspan(Offset);
-        std::transform(src.begin(), src.end(), dst.begin(), SampleConv<T>);
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+        auto gen = DitherGen4{seed};
+        for(size_t i{0};i < todo;i += 4)
+        {
+            auto s = Load4(&src[i]);
+            if(dither)
+                s = gen.apply(s, quant_scale, invscale);
+            StoreSamples<T,4>(&dst[i], s);
+        }
+#endif
+        WriteChannel<T>(src, dst, todo, 1, DitherDepth, dither_rng_skip(seed, todo*2));
+        seed = dither_rng_skip(seed, SamplesToDo*2);
         ++srcbuf;
     }
+
+    if(dither)
+        *DitherSeed = seed;
+}
+
+/* Writes silence to the interleaved output, for when the output is held. */
+template<typename T>
+void WriteSilence(void *OutBuffer, const size_t Offset, const size_t SamplesToDo,
+    const size_t FrameStep)
+{
+    const auto output = std::span{static_cast<T*>(OutBuffer), (Offset+SamplesToDo)*FrameStep}
+        .subspan(Offset*FrameStep);
+    std::fill(output.begin(), output.end(), SampleConv<T>(0.0f));
+}
+
+template<typename T>
+void WriteSilence(const std::span<void*> OutBuffers, const size_t Offset,
+    const size_t SamplesToDo)
+{
+    for(auto *dstbuf : OutBuffers)
+    {
+        const auto dst = std::span{static_cast<T*>(dstbuf), Offset+SamplesToDo}.subspan(Offset);
+        std::fill(dst.begin(), dst.end(), SampleConv<T>(0.0f));
+    }
 }
 
 } // namespace
 
+void DeviceBase::advanceClock(const uint samplesToDo) noexcept
+{
+    /* Every second's worth of samples is converted and added to clock base so
+     * that large sample counts don't overflow during conversion. This also
+     * guarantees a stable conversion.
+     */
+    auto samplesDone = mSamplesDone.load(std::memory_order_relaxed) + samplesToDo;
+    auto clockBaseSec = mClockBaseSec.load(std::memory_order_relaxed) +
+        seconds32{samplesDone/mSampleRate};
+    mSamplesDone.store(samplesDone%mSampleRate, std::memory_order_relaxed);
+    mClockBaseSec.store(clockBaseSec, std::memory_order_relaxed);
+}
+
+void DeviceBase::fadeOutputHold(const OutputHold hold, const uint samplesToDo)
+{
+    /* Ramp the real output over the whole update, out when a hold is being
+     * requested and in when being released.
+     */
+    const auto step = 1.0f / static_cast<float>(samplesToDo);
+    const auto start = (hold == OutputHold::Requested) ? 1.0f : 0.0f;
+    const auto delta = (hold == OutputHold::Requested) ? -step : step;
+    for(FloatBufferLine &buffer : RealOut.Buffer)
+    {
+        auto gain = start;
+        std::for_each(buffer.begin(), buffer.begin()+samplesToDo, [&gain,delta](float &sample)
+        {
+            gain += delta;
+            sample *= gain;
+        });
+    }
+}
+
+void DeviceBase::advanceOutputHold(OutputHold hold) noexcept
+{
+    /* Only advance if the hold state wasn't changed while mixing, otherwise
+     * the new state gets handled with the next update.
+     */
+    if(hold == OutputHold::Requested)
+        mOutputHold.compare_exchange_strong(hold, OutputHold::Held, std::memory_order_acq_rel,
+            std::memory_order_relaxed);
+    else if(hold == OutputHold::Releasing)
+        mOutputHold.compare_exchange_strong(hold, OutputHold::None, std::memory_order_acq_rel,
+            std::memory_order_relaxed);
+}
+
 uint DeviceBase::renderSamples(const uint numSamples)
 {
     const uint samplesToDo{std::min(numSamples, uint{BufferLineSize})};
@@ -2281,15 +2805,7 @@ uint DeviceBase::renderSamples(const uint numSamples)
         /* Process and mix each context's sources and effects. */
         ProcessContexts(this, samplesToDo);
 
-        /* Every second's worth of samples is converted and added to clock base
-         * so that large sample counts don't overflow during conversion. This
-         * also guarantees a stable conversion.
-         */
-        auto samplesDone = mSamplesDone.load(std::memory_order_relaxed) + samplesToDo;
-        auto clockBaseSec = mClockBaseSec.load(std::memory_order_relaxed) +
-            seconds32{samplesDone/mSampleRate};
-        mSamplesDone.store(samplesDone%mSampleRate, std::memory_order_relaxed);
-        mClockBaseSec.store(clockBaseSec, std::memory_order_relaxed);
+        advanceClock(samplesToDo);
     }
 
     /* Apply any needed post-process for finalizing the Dry mix to the RealOut
@@ -2304,12 +2820,6 @@ uint DeviceBase::renderSamples(const uint numSamples)
     if(ChannelDelays)
         ApplyDistanceComp(RealOut.Buffer, samplesToDo, ChannelDelays->mChannels);
 
-    /* Apply dithering. The compressor should have left enough headroom for the
-     * dither noise to not saturate.
-     */
-    if(DitherDepth > 0.0f)
-        ApplyDither(RealOut.Buffer, &DitherSeed, DitherDepth, samplesToDo);
-
     return samplesToDo;
 }
 
@@ -2319,12 +2829,42 @@ void DeviceBase::renderSamples(const std::span<void*> outBuffers, const uint num
     uint total{0};
     while(const uint todo{numSamples - total})
     {
+        const auto hold = mOutputHold.load(std::memory_order_acquire);
+        if(hold == OutputHold::Held) [[unlikely]]
+        {
+            /* The renderer is being reconfigured, so don't touch it and write
+             * silence for the rest of the update. The clock still advances
+             * with the output, to stay in step with the backend.
+             */
+            {
+                const auto mixLock = getWriteMixLock();
+                advanceClock(todo);
+            }
+            switch(FmtType)
+            {
+#define HANDLE_WRITE(T) case T:                                               \
+    WriteSilence<DevFmtType_t<T>>(outBuffers, total, todo); break;
+            HANDLE_WRITE(DevFmtByte)
+            HANDLE_WRITE(DevFmtUByte)
+            HANDLE_WRITE(DevFmtShort)
+            HANDLE_WRITE(DevFmtUShort)
+            HANDLE_WRITE(DevFmtInt)
+            HANDLE_WRITE(DevFmtUInt)
+            HANDLE_WRITE(DevFmtFloat)
+#undef HANDLE_WRITE
+            }
+            break;
+        }
+
         const uint samplesToDo{renderSamples(todo)};
+        if(hold != OutputHold::None) [[unlikely]]
+            fadeOutputHold(hold, samplesToDo);
 
         switch(FmtType)
         {
 #define HANDLE_WRITE(T) case T:                                               \
-    Write<DevFmtType_t<T>>(RealOut.Buffer, outBuffers, total, samplesToDo); break;
+    Write<DevFmtType_t<T>>(RealOut.Buffer, outBuffers, total, samplesToDo,      \
+        DitherDepth, &DitherSeed); break;
         HANDLE_WRITE(DevFmtByte)
         HANDLE_WRITE(DevFmtUByte)
         HANDLE_WRITE(DevFmtShort)
@@ -2336,6 +2876,8 @@ void DeviceBase::renderSamples(const std::span<void*> outBuffers, const uint num
 #undef HANDLE_WRITE
 
         total += samplesToDo;
+        if(hold != OutputHold::None) [[unlikely]]
+            advanceOutputHold(hold);
     }
 }
 
@@ -2345,17 +2887,52 @@ void DeviceBase::renderSamples(void *outBuffer, const uint numSamples, const siz
     uint total{0};
     while(const uint todo{numSamples - total})
     {
+        const auto hold = mOutputHold.load(std::memory_order_acquire);
+        if(hold == OutputHold::Held) [[unlikely]]
+        {
+            /* The renderer is being reconfigured, so don't touch it and write
+             * silence for the rest of the update. The clock still advances
+             * with the output, to stay in step with the backend.
+             */
+            {
+                const auto mixLock = getWriteMixLock();
+                advanceClock(todo);
+            }
+            if(outBuffer) [[likely]]
+            {
+                switch(FmtType)
+                {
+#define HANDLE_WRITE(T) case T:                                               \
+    WriteSilence<DevFmtType_t<T>>(outBuffer, total, todo, frameStep); break;
+                HANDLE_WRITE(DevFmtByte)
+                HANDLE_WRITE(DevFmtUByte)
+                HANDLE_WRITE(DevFmtShort)
+                HANDLE_WRITE(DevFmtUShort)
+                HANDLE_WRITE(DevFmtInt)
+                HANDLE_WRITE(DevFmtUInt)
+                HANDLE_WRITE(DevFmtFloat)
+#undef HANDLE_WRITE
+                }
+            }
+            break;
+        }
+
         const uint samplesToDo{renderSamples(todo)};
+        if(hold != OutputHold::None) [[unlikely]]
+            fadeOutputHold(hold, samplesToDo);
 
         if(outBuffer) [[likely]]
         {
             /* Finally, interleave and convert samples, writing to the device's
-             * output buffer.
+             * output buffer. Dithering is applied here too; the compressor
+             * should have left enough headroom for the dither noise to not
+             * saturate.
              */
             switch(FmtType)
             {
 #define HANDLE_WRITE(T) case T:                                               \
-    Write<DevFmtType_t<T>>(RealOut.Buffer, outBuffer, total, samplesToDo, frameStep); break;
+    Write<DevFmtType_t<T>>(RealOut.Buffer, outBuffer, total, samplesToDo, frameStep, \
+        DitherDepth, &DitherSeed); break;
             HANDLE_WRITE(DevFmtByte)
             HANDLE_WRITE(DevFmtUByte)
             HANDLE_WRITE(DevFmtShort)
@@ -2368,11 +2945,34 @@ void DeviceBase::renderSamples(void *outBuffer, const uint numSamples, const siz
         }
 
         total += samplesToDo;
+        if(hold != OutputHold::None) [[unlikely]]
+            advanceOutputHold(hold);
     }
 }
 
 void DeviceBase::doDisconnect(std::string msg)
 {
+    const auto hold = mOutputHold.load(std::memory_order_acquire);
+    if(hold == OutputHold::Requested || hold == OutputHold::Held) [[unlikely]]
+    {
+        /* The renderer may be getting updated, so it can't be touched. Leave
+         * the disconnect for the update to handle after stopping the backend.
+         * If the hold was released in the mean time, the update may have
+         * already checked, so take it back to handle here.
+         */
+        if(mDisconnectPending.load(std::memory_order_acquire))
+            return;
+        mPendingDisconnectMsg = std::move(msg);
+        mDisconnectPending.store(true, std::memory_order_release);
+
+        const auto newhold = mOutputHold.load(std::memory_order_acquire);
+        if(newhold == OutputHold::Requested || newhold == OutputHold::Held)
+            return;
+        if(!mDisconnectPending.exchange(false, std::memory_order_acq_rel))
+            return;
+        msg = std::move(mPendingDisconnectMsg);
+    }
+
     const auto mixLock = getWriteMixLock();
 
     if(Connected.exchange(false, std::memory_order_acq_rel))
@@ -2412,3 +3012,13 @@ void DeviceBase::doDisconnect(std::string msg)
         }
     }
 }
+
+bool DeviceBase::handlePendingDisconnect()
+{
+    if(!mDisconnectPending.exchange(false, std::memory_order_acq_rel))
+        return false;
+
+    mOutputHold.store(OutputHold::None, std::memory_order_relaxed);
+    doDisconnect(std::move(mPendingDisconnectMsg));
+    return true;
+}
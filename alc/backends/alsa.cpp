@@ -448,6 +448,74 @@ int verify_state(snd_pcm_t *handle)
 }
 
 
+/* Tracks how much of the device buffer the mixer keeps filled. It starts out
+ * using the whole buffer, backs off one period at a time while wakeups keep
+ * arriving with more than a period still queued, and grows again by a period
+ * whenever an underrun happens.
+ */
+struct AdaptiveFill {
+    static constexpr auto ShrinkInterval = std::chrono::seconds{10};
+
+    snd_pcm_uframes_t mUpdateSize{};
+    snd_pcm_uframes_t mBufferSize{};
+    snd_pcm_uframes_t mTarget{};
+    snd_pcm_uframes_t mMinQueued{};
+    std::chrono::steady_clock::time_point mWindowStart;
+
+    void reset(snd_pcm_uframes_t update_size, snd_pcm_uframes_t buffer_size) noexcept
+    {
+        mUpdateSize = update_size;
+        mBufferSize = buffer_size;
+        mTarget = buffer_size;
+        restartWindow();
+    }
+
+    void restartWindow() noexcept
+    {
+        mMinQueued = mBufferSize;
+        mWindowStart = std::chrono::steady_clock::now();
+    }
+
+    /* The avail_min needed to wake up once a period can be written without
+     * exceeding the target.
+     */
+    [[nodiscard]]
+    auto availMin() const noexcept -> snd_pcm_uframes_t
+    { return mBufferSize - mTarget + mUpdateSize; }
+
+    /* Returns true if the target changed. */
+    bool xrun() noexcept
+    {
+        const auto target = std::min(mTarget+mUpdateSize, mBufferSize);
+        restartWindow();
+        if(target == mTarget)
+            return false;
+        mTarget = target;
+        return true;
+    }
+
+    /* Records how many frames were still queued when the mixer woke up.
+     * Returns true if the target changed.
+     */
+    bool wakeup(snd_pcm_uframes_t queued) noexcept
+    {
+        mMinQueued = std::min(mMinQueued, queued);
+        if(std::chrono::steady_clock::now() - mWindowStart < ShrinkInterval)
+            return false;
+
+        /* Only give up a period if every wakeup in the window had more than
+         * a period to spare, and never go below two periods.
+         */
+        const bool shrink{mMinQueued > mUpdateSize && mTarget > mUpdateSize*2};
+        restartWindow();
+        if(!shrink)
+            return false;
+        mTarget -= mUpdateSize;
+        return true;
+    }
+};
+
+
 struct AlsaPlayback final : public BackendBase {
     explicit AlsaPlayback(DeviceBase *device) noexcept : BackendBase{device} { }
     ~AlsaPlayback() override;
@@ -455,6 +523,9 @@ struct AlsaPlayback final : public BackendBase {
     int mixerProc();
     int mixerNoMMapProc();
 
+    void setAvailMin(snd_pcm_uframes_t avail_min);
+    void updateTarget(bool changed);
+
     void open(std::string_view name) override;
     bool reset() override;
     void start() override;
@@ -469,6 +540,9 @@ struct AlsaPlayback final : public BackendBase {
     uint mFrameStep{};
     std::vector<std::byte> mBuffer;
 
+    bool mAdaptive{false};
+    AdaptiveFill mFill;
+
     std::atomic<bool> mKillNow{true};
     std::thread mThread;
 };
@@ -481,6 +555,26 @@ AlsaPlayback::~AlsaPlayback()
 }
 
 
+void AlsaPlayback::setAvailMin(snd_pcm_uframes_t avail_min)
+{
+    SwParamsPtr sp{CreateSwParams()};
+    std::lock_guard<std::mutex> dlock{mMutex};
+    int err{snd_pcm_sw_params_current(mPcmHandle, sp.get())};
+    if(err >= 0) err = snd_pcm_sw_params_set_avail_min(mPcmHandle, sp.get(), avail_min);
+    if(err >= 0) err = snd_pcm_sw_params(mPcmHandle, sp.get());
+    if(err < 0)
+        ERR("Failed to set avail_min to {}: {}", avail_min, snd_strerror(err));
+}
+
+void AlsaPlayback::updateTarget(bool changed)
+{
+    if(!changed)
+        return;
+    TRACE("Adaptive latency target now {} of {} frames", mFill.mTarget, mFill.mBufferSize);
+    setAvailMin(mFill.availMin());
+}
+
+
 int AlsaPlayback::mixerProc()
 {
     SetRTPriority();
@@ -513,6 +607,18 @@ int AlsaPlayback::mixerProc()
             continue;
         }
 
+        if(mAdaptive)
+        {
+            if(state == SND_PCM_STATE_XRUN)
+                updateTarget(mFill.xrun());
+            else if(state == SND_PCM_STATE_RUNNING)
+                updateTarget(mFill.wakeup(buffer_size - avail));
+            /* Only fill up to the target, leaving the rest of the buffer
+             * empty.
+             */
+            avail -= std::min(avail, mFill.availMin() - update_size);
+        }
+
         // make sure there's frames to process
         if(avail < update_size)
         {
@@ -596,6 +702,17 @@ int AlsaPlayback::mixerNoMMapProc()
             continue;
         }
 
+        if(mAdaptive)
+        {
+            const auto uavail = static_cast<snd_pcm_uframes_t>(avail);
+            if(state == SND_PCM_STATE_XRUN)
+                updateTarget(mFill.xrun());
+            else if(state == SND_PCM_STATE_RUNNING)
+                updateTarget(mFill.wakeup(buffer_size - uavail));
+            avail = static_cast<snd_pcm_sframes_t>(uavail
+                - std::min(uavail, mFill.availMin() - update_size));
+        }
+
         if(static_cast<snd_pcm_uframes_t>(avail) < update_size)
         {
             if(state != SND_PCM_STATE_RUNNING)
@@ -629,6 +746,8 @@ int AlsaPlayback::mixerNoMMapProc()
 #endif
             case -EPIPE:
             case -EINTR:
+                if(ret == -EPIPE && mAdaptive)
+                    updateTarget(mFill.xrun());
                 ret = snd_pcm_recover(mPcmHandle, static_cast<int>(ret), 1);
                 if(ret < 0)
                     avail = 0;
@@ -818,6 +937,10 @@ bool AlsaPlayback::reset()
     mDevice->mUpdateSize = static_cast<uint>(periodSizeInFrames);
     mDevice->mSampleRate = rate;
 
+    mAdaptive = GetConfigValueBool(mDevice->mDeviceName, "alsa"sv, "adaptive-latency"sv, false)
+        && bufferSizeInFrames > periodSizeInFrames*2;
+    mFill.reset(periodSizeInFrames, bufferSizeInFrames);
+
     setDefaultChannelOrder();
 
     return true;
@@ -851,6 +974,7 @@ void AlsaPlayback::start()
     }
 #undef CHECK
 
+    mFill.restartWindow();
     try {
         mKillNow.store(false, std::memory_order_release);
         mThread = std::thread{thread_func, this};
@@ -901,6 +1025,7 @@ struct AlsaCapture final : public BackendBase {
     void stop() override;
     void captureSamples(std::byte *buffer, uint samples) override;
     uint availableSamples() override;
+    auto getCaptureRing() -> RingBuffer* override;
     ClockLatency getClockLatency() override;
 
     snd_pcm_t *mPcmHandle{nullptr};
@@ -1193,6 +1318,9 @@ uint AlsaCapture::availableSamples()
     return static_cast<uint>(mRing->readSpace());
 }
 
+auto AlsaCapture::getCaptureRing() -> RingBuffer*
+{ return mRing.get(); }
+
 ClockLatency AlsaCapture::getClockLatency()
 {
     ClockLatency ret{};
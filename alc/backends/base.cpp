@@ -27,6 +27,9 @@ void BackendBase::captureSamples(std::byte*, uint)
 uint BackendBase::availableSamples()
 { return 0; }
 
+auto BackendBase::getCaptureRing() -> RingBuffer*
+{ return nullptr; }
+
 ClockLatency BackendBase::getClockLatency()
 {
     ClockLatency ret{};
@@ -13,6 +13,7 @@
 #include "core/device.h"
 #include "core/except.h"
 #include "fmt/core.h"
+#include "ringbuffer.h"
 
 
 using uint = unsigned int;
@@ -31,6 +32,12 @@ struct BackendBase {
 
     virtual void captureSamples(std::byte *buffer, uint samples);
     virtual uint availableSamples();
+    /**
+     * Returns the ring buffer captured samples are read from, if the backend
+     * has one holding samples in the device format. Reading it directly must
+     * be equivalent to captureSamples, after availableSamples has been called.
+     */
+    virtual auto getCaptureRing() -> RingBuffer*;
 
     virtual ClockLatency getClockLatency();
 
@@ -0,0 +1,227 @@
+
+#include "config.h"
+
+#include "mixerpool.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "althrd_setname.h"
+#include "core/device.h"
+#include "core/helpers.h"
+#include "core/logging.h"
+
+
+using std::chrono::seconds;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+struct MixerPool {
+    std::mutex mLock;
+    /* Idle threads wait on mCond for work. Only one thread at a time waits
+     * on mTimerCond for the earliest deadline, so each deadline wakes a
+     * single thread instead of the whole pool.
+     */
+    std::condition_variable mCond;
+    std::condition_variable mTimerCond;
+    std::condition_variable mStopCond;
+    bool mHasTimer{false};
+
+    /* Queued mixers, as a min-heap on their deadlines. */
+    std::vector<PooledMixer*> mQueue;
+    size_t mNumMixers{0};
+    bool mQuit{false};
+
+    /* Serializes starting and stopping the threads. */
+    std::mutex mThreadLock;
+    std::vector<std::thread> mThreads;
+
+    static auto Get() -> MixerPool&
+    {
+        /* Intentionally leaked, so process exit doesn't try to destroy
+         * threads that may still be joinable.
+         */
+        static auto *pool = new MixerPool{};
+        return *pool;
+    }
+
+    static bool LaterDeadline(const PooledMixer *lhs, const PooledMixer *rhs) noexcept
+    { return lhs->mDeadline > rhs->mDeadline; }
+
+    static void SetDeadline(PooledMixer *mixer) noexcept
+    {
+        DeviceBase *device{mixer->mDevice};
+
+        /* For every completed second, increment the start time and reduce
+         * the samples done. This keeps the sample count small, while
+         * maintaining the correct number of samples to render.
+         */
+        if(mixer->mDone >= device->mSampleRate)
+        {
+            const seconds s{mixer->mDone/device->mSampleRate};
+            mixer->mStart += s;
+            mixer->mDone -= device->mSampleRate*s.count();
+        }
+        mixer->mDeadline = mixer->mStart + nanoseconds{seconds{mixer->mDone
+            + device->mUpdateSize}} / device->mSampleRate;
+    }
+
+    void enqueue(PooledMixer *mixer)
+    {
+        mixer->mQueued = true;
+        mQueue.emplace_back(mixer);
+        std::push_heap(mQueue.begin(), mQueue.end(), LaterDeadline);
+
+        /* If this is now the earliest deadline, the timer thread needs to
+         * wait on it instead. Otherwise make sure some thread is timing.
+         */
+        if(mQueue.front() == mixer)
+            mTimerCond.notify_one();
+        if(!mHasTimer)
+            mCond.notify_one();
+    }
+
+    void dequeue(PooledMixer *mixer)
+    {
+        auto iter = std::find(mQueue.begin(), mQueue.end(), mixer);
+        if(iter != mQueue.end())
+        {
+            mQueue.erase(iter);
+            std::make_heap(mQueue.begin(), mQueue.end(), LaterDeadline);
+        }
+        mixer->mQueued = false;
+    }
+
+    int mixerProc();
+};
+
+int MixerPool::mixerProc()
+{
+    SetRTPriority();
+    althrd_setname(GetMixerThreadName());
+
+    auto plock = std::unique_lock{mLock};
+    while(!mQuit)
+    {
+        if(mQueue.empty())
+        {
+            mCond.wait(plock);
+            continue;
+        }
+
+        PooledMixer *mixer{mQueue.front()};
+        if(steady_clock::now() < mixer->mDeadline)
+        {
+            if(mHasTimer)
+                mCond.wait(plock);
+            else
+            {
+                mHasTimer = true;
+                mTimerCond.wait_until(plock, mixer->mDeadline);
+                mHasTimer = false;
+            }
+            continue;
+        }
+        std::pop_heap(mQueue.begin(), mQueue.end(), LaterDeadline);
+        mQueue.pop_back();
+        mixer->mQueued = false;
+        mixer->mRunning = true;
+
+        /* Let an idle thread take over waiting on the next deadline while
+         * this one mixes.
+         */
+        if(!mQueue.empty() && !mHasTimer)
+            mCond.notify_one();
+
+        plock.unlock();
+        const bool ok{mixer->mDevice->Connected.load(std::memory_order_acquire)
+            && mixer->mUpdate()};
+        plock.lock();
+
+        mixer->mRunning = false;
+        if(ok && mixer->mActive)
+        {
+            mixer->mDone += mixer->mDevice->mUpdateSize;
+            SetDeadline(mixer);
+            enqueue(mixer);
+        }
+        else
+            mStopCond.notify_all();
+    }
+
+    return 0;
+}
+
+
+void PooledMixer::start()
+{
+    MixerPool &pool = MixerPool::Get();
+
+    auto tlock = std::lock_guard{pool.mThreadLock};
+    {
+        auto plock = std::lock_guard{pool.mLock};
+        if(mActive)
+            return;
+        mActive = true;
+        mStart = steady_clock::now();
+        mDone = 0;
+        MixerPool::SetDeadline(this);
+        pool.enqueue(this);
+        ++pool.mNumMixers;
+        pool.mQuit = false;
+    }
+
+    if(pool.mThreads.empty())
+    {
+        const auto numthreads = std::max(std::thread::hardware_concurrency(), 1u);
+        TRACE("Starting {} pooled mixer thread{}", numthreads, (numthreads==1) ? "" : "s");
+        try {
+            for(uint i{0};i < numthreads;++i)
+                pool.mThreads.emplace_back(&MixerPool::mixerProc, &pool);
+        }
+        catch(std::exception &e) {
+            if(pool.mThreads.empty())
+            {
+                {
+                    auto plock = std::lock_guard{pool.mLock};
+                    pool.dequeue(this);
+                    --pool.mNumMixers;
+                    mActive = false;
+                }
+                throw;
+            }
+            WARN("Only started {} pooled mixer threads: {}", pool.mThreads.size(), e.what());
+        }
+    }
+}
+
+void PooledMixer::stop()
+{
+    MixerPool &pool = MixerPool::Get();
+
+    auto tlock = std::lock_guard{pool.mThreadLock};
+    {
+        auto plock = std::unique_lock{pool.mLock};
+        if(!mActive)
+            return;
+
+        mActive = false;
+        pool.mStopCond.wait(plock, [this]{ return !mRunning; });
+        pool.dequeue(this);
+
+        if(--pool.mNumMixers > 0)
+            return;
+        pool.mQuit = true;
+    }
+    pool.mCond.notify_all();
+    pool.mTimerCond.notify_all();
+
+    /* No more mixers, so stop the threads until a mixer starts again. */
+    for(auto &thread : pool.mThreads)
+        thread.join();
+    pool.mThreads.clear();
+}
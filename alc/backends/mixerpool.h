@@ -0,0 +1,48 @@
+#ifndef BACKENDS_MIXERPOOL_H
+#define BACKENDS_MIXERPOOL_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+struct DeviceBase;
+
+/* Mixes a timer-driven playback device (one that doesn't wait on an audio
+ * API to take samples) on a process-wide set of mixer threads, instead of
+ * giving each device its own thread. Devices are updated in order of their
+ * next update's deadline.
+ */
+class PooledMixer {
+public:
+    /* Renders and outputs one update. Returns false if the device failed and
+     * should no longer be mixed.
+     */
+    using UpdateFunc = std::function<bool()>;
+
+    PooledMixer(DeviceBase *device, UpdateFunc update)
+        : mDevice{device}, mUpdate{std::move(update)}
+    { }
+    PooledMixer(const PooledMixer&) = delete;
+    PooledMixer& operator=(const PooledMixer&) = delete;
+    ~PooledMixer() { stop(); }
+
+    void start();
+    /* Stops mixing, waiting for any in-progress update to finish. */
+    void stop();
+
+private:
+    DeviceBase *const mDevice;
+    const UpdateFunc mUpdate;
+
+    /* Scheduling state, protected by the pool's lock. */
+    std::chrono::steady_clock::time_point mStart;
+    int64_t mDone{0};
+    std::chrono::steady_clock::time_point mDeadline;
+    bool mActive{false};
+    bool mQueued{false};
+    bool mRunning{false};
+
+    friend struct MixerPool;
+};
+
+#endif /* BACKENDS_MIXERPOOL_H */
@@ -27,11 +27,14 @@
 #include <chrono>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <thread>
 
+#include "alc/alconfig.h"
 #include "althrd_setname.h"
 #include "core/device.h"
 #include "core/helpers.h"
+#include "mixerpool.h"
 
 
 namespace {
@@ -56,6 +59,8 @@ struct NullBackend final : public BackendBase {
 
     std::atomic<bool> mKillNow{true};
     std::thread mThread;
+
+    std::optional<PooledMixer> mPooledMixer;
 };
 
 int NullBackend::mixerProc()
@@ -123,10 +128,22 @@ bool NullBackend::reset()
 void NullBackend::start()
 {
     try {
+        if(GetConfigValueBool({}, "null", "shared-mixer", false))
+        {
+            mPooledMixer.emplace(mDevice, [this]
+            {
+                mDevice->renderSamples(nullptr, mDevice->mUpdateSize, 0u);
+                return true;
+            });
+            mPooledMixer->start();
+            return;
+        }
+
         mKillNow.store(false, std::memory_order_release);
         mThread = std::thread{&NullBackend::mixerProc, this};
     }
     catch(std::exception& e) {
+        mPooledMixer.reset();
         throw al::backend_exception{al::backend_error::DeviceError,
             "Failed to start mixing thread: {}", e.what()};
     }
@@ -134,6 +151,12 @@ void NullBackend::start()
 
 void NullBackend::stop()
 {
+    if(mPooledMixer)
+    {
+        mPooledMixer.reset();
+        return;
+    }
+
     if(mKillNow.exchange(true, std::memory_order_acq_rel) || !mThread.joinable())
         return;
     mThread.join();
@@ -464,6 +464,7 @@ struct OSScapture final : public BackendBase {
     void stop() override;
     void captureSamples(std::byte *buffer, uint samples) override;
     uint availableSamples() override;
+    auto getCaptureRing() -> RingBuffer* override;
 
     int mFd{-1};
 
@@ -639,6 +640,9 @@ void OSScapture::captureSamples(std::byte *buffer, uint samples)
 uint OSScapture::availableSamples()
 { return static_cast<uint>(mRing->readSpace()); }
 
+auto OSScapture::getCaptureRing() -> RingBuffer*
+{ return mRing.get(); }
+
 } // namespace
 
 
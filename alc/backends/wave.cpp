@@ -32,10 +32,13 @@
 #include <cstring>
 #include <exception>
 #include <functional>
+#include <optional>
+#include <span>
 #include <system_error>
 #include <thread>
 #include <vector>
 
+#include "albit.h"
 #include "alc/alconfig.h"
 #include "almalloc.h"
 #include "alnumeric.h"
@@ -43,6 +46,8 @@
 #include "althrd_setname.h"
 #include "core/device.h"
 #include "core/logging.h"
+#include "mixerpool.h"
+#include "ringbuffer.h"
 #include "strutils.h"
 
 
@@ -128,12 +133,34 @@ void fwrite64be(uint64_t val, FILE *f)
     fwrite(data.data(), 1, data.size(), f);
 }
 
+/* Swaps the byte order of the samples in place, using whole samples so the
+ * loop can be vectorized.
+ */
+template<std::integral T>
+void SwapSampleBytes(const std::span<std::byte> buffer) noexcept
+{
+    const auto count = buffer.size() / sizeof(T);
+    for(size_t i{0};i < count;++i)
+    {
+        const auto sample = buffer.subspan(i*sizeof(T), sizeof(T));
+        T value;
+        std::memcpy(&value, sample.data(), sizeof(T));
+        value = al::byteswap(value);
+        std::memcpy(sample.data(), &value, sizeof(T));
+    }
+}
+
 
 struct WaveBackend final : public BackendBase {
     explicit WaveBackend(DeviceBase *device) noexcept : BackendBase{device} { }
     ~WaveBackend() override;
 
+    void swapBytes(const std::span<std::byte> buffer) const noexcept;
+
+    bool mixUpdate();
     int mixerProc();
+    int offlineMixerProc();
+    int writerProc();
 
     void open(std::string_view name) override;
     bool reset() override;
@@ -146,21 +173,62 @@ struct WaveBackend final : public BackendBase {
     std::vector<std::byte> mBuffer;
     bool mCAFOutput{};
 
+    /* Offline rendering mixes as fast as possible, handing the samples to a
+     * separate writer thread through the ring buffer.
+     */
+    bool mOffline{};
+    RingBufferPtr mRing;
+    std::atomic<bool> mMixerSignal{false};
+    std::atomic<bool> mWriterSignal{false};
+    std::atomic<bool> mMixerDone{false};
+    std::atomic<bool> mWriteFailed{false};
+
     std::atomic<bool> mKillNow{true};
     std::thread mThread;
+    std::thread mWriterThread;
+
+    std::optional<PooledMixer> mPooledMixer;
 };
 
 WaveBackend::~WaveBackend() = default;
 
-int WaveBackend::mixerProc()
+void WaveBackend::swapBytes(const std::span<std::byte> buffer) const noexcept
 {
-    const milliseconds restTime{mDevice->mUpdateSize*1000/mDevice->mSampleRate / 2};
+    if(std::endian::native == std::endian::little || mCAFOutput)
+        return;
 
-    althrd_setname(GetMixerThreadName());
+    const uint bytesize{mDevice->bytesFromFmt()};
+    if(bytesize == 2)
+        SwapSampleBytes<uint16_t>(buffer);
+    else if(bytesize == 4)
+        SwapSampleBytes<uint32_t>(buffer);
+}
 
+bool WaveBackend::mixUpdate()
+{
     const size_t frameStep{mDevice->channelsFromFmt()};
     const size_t frameSize{mDevice->frameSizeFromFmt()};
 
+    mDevice->renderSamples(mBuffer.data(), mDevice->mUpdateSize, frameStep);
+
+    swapBytes(mBuffer);
+
+    const size_t fs{fwrite(mBuffer.data(), frameSize, mDevice->mUpdateSize, mFile.get())};
+    if(fs < mDevice->mUpdateSize || ferror(mFile.get()))
+    {
+        ERR("Error writing to file");
+        mDevice->handleDisconnect("Failed to write playback samples");
+        return false;
+    }
+    return true;
+}
+
+int WaveBackend::mixerProc()
+{
+    const milliseconds restTime{mDevice->mUpdateSize*1000/mDevice->mSampleRate / 2};
+
+    althrd_setname(GetMixerThreadName());
+
     int64_t done{0};
     auto start = std::chrono::steady_clock::now();
     while(!mKillNow.load(std::memory_order_acquire)
@@ -178,37 +246,9 @@ int WaveBackend::mixerProc()
         }
         while(avail-done >= mDevice->mUpdateSize)
         {
-            mDevice->renderSamples(mBuffer.data(), mDevice->mUpdateSize, frameStep);
             done += mDevice->mUpdateSize;
-
-            if(std::endian::native != std::endian::little && !mCAFOutput)
-            {
-                const uint bytesize{mDevice->bytesFromFmt()};
-
-                if(bytesize == 2)
-                {
-                    const size_t len{mBuffer.size() & ~1_uz};
-                    for(size_t i{0};i < len;i+=2)
-                        std::swap(mBuffer[i], mBuffer[i+1]);
-                }
-                else if(bytesize == 4)
-                {
-                    const size_t len{mBuffer.size() & ~3_uz};
-                    for(size_t i{0};i < len;i+=4)
-                    {
-                        std::swap(mBuffer[i  ], mBuffer[i+3]);
-                        std::swap(mBuffer[i+1], mBuffer[i+2]);
-                    }
-                }
-            }
-
-            const size_t fs{fwrite(mBuffer.data(), frameSize, mDevice->mUpdateSize, mFile.get())};
-            if(fs < mDevice->mUpdateSize || ferror(mFile.get()))
-            {
-                ERR("Error writing to file");
-                mDevice->handleDisconnect("Failed to write playback samples");
+            if(!mixUpdate())
                 break;
-            }
         }
 
         /* For every completed second, increment the start time and reduce the
@@ -227,6 +267,117 @@ int WaveBackend::mixerProc()
     return 0;
 }
 
+int WaveBackend::offlineMixerProc()
+{
+    althrd_setname(GetMixerThreadName());
+
+    const auto updateSize = size_t{mDevice->mUpdateSize};
+    const auto frameStep = size_t{mDevice->channelsFromFmt()};
+    const auto frameSize = size_t{mDevice->frameSizeFromFmt()};
+
+    auto total = uint64_t{0};
+    const auto start = std::chrono::steady_clock::now();
+    while(!mKillNow.load(std::memory_order_acquire)
+        && mDevice->Connected.load(std::memory_order_acquire))
+    {
+        /* The writer can't disconnect the device itself while the mixer is
+         * running, so it flags the failure for this thread to handle.
+         */
+        if(mWriteFailed.load(std::memory_order_acquire))
+        {
+            mDevice->handleDisconnect("Failed to write playback samples");
+            break;
+        }
+
+        if(mRing->writeSpace() < updateSize)
+        {
+            mMixerSignal.wait(false, std::memory_order_acquire);
+            mMixerSignal.store(false, std::memory_order_release);
+            continue;
+        }
+
+        /* Render one update at a time, so the writer can work on it while the
+         * next one is mixed.
+         */
+        auto todo = updateSize;
+        for(const auto &data : mRing->getWriteVector())
+        {
+            const auto len = std::min(data.len, todo);
+            if(len == 0) break;
+
+            mDevice->renderSamples(data.buf, static_cast<uint>(len), frameStep);
+            swapBytes(std::span{data.buf, len*frameSize});
+            todo -= len;
+        }
+        mRing->writeAdvance(updateSize);
+        total += updateSize;
+
+        mWriterSignal.store(true, std::memory_order_release);
+        mWriterSignal.notify_all();
+    }
+
+    const auto elapsed = std::chrono::duration<double>{std::chrono::steady_clock::now() - start};
+    const auto rendered = static_cast<double>(total) / mDevice->mSampleRate;
+    /* Offline rendering is only enabled on request, so report how fast it
+     * went even at the default log level.
+     */
+    ERR("Rendered {:.3f}s of audio in {:.3f}s ({:.2f}x real-time)", rendered, elapsed.count(),
+        (elapsed.count() > 0.0) ? rendered/elapsed.count() : 0.0);
+
+    mMixerDone.store(true, std::memory_order_release);
+    mWriterSignal.store(true, std::memory_order_release);
+    mWriterSignal.notify_all();
+
+    return 0;
+}
+
+int WaveBackend::writerProc()
+{
+    althrd_setname("alsoft-wave-writer");
+
+    const auto frameSize = size_t{mDevice->frameSizeFromFmt()};
+
+    while(true)
+    {
+        /* Check if the mixer is done before checking for data, so anything it
+         * wrote before finishing gets written out.
+         */
+        const auto mixerDone = mMixerDone.load(std::memory_order_acquire);
+        const auto data = mRing->getReadVector();
+        if(data[0].len == 0)
+        {
+            if(mixerDone)
+                break;
+            mWriterSignal.wait(false, std::memory_order_acquire);
+            mWriterSignal.store(false, std::memory_order_release);
+            continue;
+        }
+
+        auto written = size_t{0};
+        for(const auto &block : data)
+        {
+            if(block.len == 0) break;
+            written += fwrite(block.buf, frameSize, block.len, mFile.get());
+        }
+        mRing->readAdvance(written);
+
+        const auto failed = written < data[0].len+data[1].len || ferror(mFile.get());
+        if(failed)
+        {
+            ERR("Error writing to file");
+            mWriteFailed.store(true, std::memory_order_release);
+        }
+
+        mMixerSignal.store(true, std::memory_order_release);
+        mMixerSignal.notify_all();
+
+        if(failed)
+            break;
+    }
+
+    return 0;
+}
+
 void WaveBackend::open(std::string_view name)
 {
     auto fname = ConfigValueStr({}, "wave", "file");
@@ -463,8 +614,23 @@ bool WaveBackend::reset()
 
     setDefaultWFXChannelOrder();
 
-    const uint bufsize{mDevice->frameSizeFromFmt() * mDevice->mUpdateSize};
-    mBuffer.resize(bufsize);
+    mOffline = GetConfigValueBool({}, "wave", "offline", false);
+    if(!mOffline)
+    {
+        const uint bufsize{mDevice->frameSizeFromFmt() * mDevice->mUpdateSize};
+        mBuffer.resize(bufsize);
+        mRing = nullptr;
+    }
+    else
+    {
+        /* Hold about a second of samples, in whole updates, to absorb stalls
+         * from the file writes.
+         */
+        const auto numUpdates = std::max(mDevice->mSampleRate/mDevice->mUpdateSize, 2u);
+        mRing = RingBuffer::Create(size_t{numUpdates}*mDevice->mUpdateSize,
+            mDevice->frameSizeFromFmt(), true);
+        decltype(mBuffer){}.swap(mBuffer);
+    }
 
     return true;
 }
@@ -472,10 +638,36 @@ bool WaveBackend::reset()
 void WaveBackend::start()
 {
     try {
+        if(!mOffline && GetConfigValueBool({}, "wave", "shared-mixer", false))
+        {
+            mPooledMixer.emplace(mDevice, [this]{ return mixUpdate(); });
+            mPooledMixer->start();
+            return;
+        }
+
         mKillNow.store(false, std::memory_order_release);
-        mThread = std::thread{&WaveBackend::mixerProc, this};
+        if(!mOffline)
+            mThread = std::thread{&WaveBackend::mixerProc, this};
+        else
+        {
+            mRing->reset();
+            mMixerSignal.store(false, std::memory_order_relaxed);
+            mWriterSignal.store(false, std::memory_order_relaxed);
+            mWriteFailed.store(false, std::memory_order_relaxed);
+            mMixerDone.store(false, std::memory_order_release);
+            mWriterThread = std::thread{&WaveBackend::writerProc, this};
+            mThread = std::thread{&WaveBackend::offlineMixerProc, this};
+        }
     }
     catch(std::exception& e) {
+        mPooledMixer.reset();
+        if(mWriterThread.joinable())
+        {
+            mMixerDone.store(true, std::memory_order_release);
+            mWriterSignal.store(true, std::memory_order_release);
+            mWriterSignal.notify_all();
+            mWriterThread.join();
+        }
         throw al::backend_exception{al::backend_error::DeviceError,
             "Failed to start mixing thread: {}", e.what()};
     }
@@ -483,9 +675,19 @@ void WaveBackend::start()
 
 void WaveBackend::stop()
 {
-    if(mKillNow.exchange(true, std::memory_order_acq_rel) || !mThread.joinable())
-        return;
-    mThread.join();
+    if(mPooledMixer)
+        mPooledMixer.reset();
+    else
+    {
+        if(mKillNow.exchange(true, std::memory_order_acq_rel) || !mThread.joinable())
+            return;
+        /* Wake the offline mixer in case it's waiting on the writer. */
+        mMixerSignal.store(true, std::memory_order_release);
+        mMixerSignal.notify_all();
+        mThread.join();
+        if(mWriterThread.joinable())
+            mWriterThread.join();
+    }
 
     if(mDataStart > 0)
     {
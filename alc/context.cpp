@@ -79,23 +79,31 @@ std::vector<std::string_view> getContextExtensions() noexcept
         "AL_SOFT_block_alignment"sv,
         "AL_SOFT_buffer_length_query"sv,
         "AL_SOFT_callback_buffer"sv,
+        "AL_SOFTX_context_preallocation"sv,
         "AL_SOFTX_convolution_effect"sv,
         "AL_SOFT_deferred_updates"sv,
         "AL_SOFT_direct_channels"sv,
         "AL_SOFT_direct_channels_remix"sv,
+#if ALSOFT_EAX
+        "AL_SOFTX_eax_commit_stats"sv,
+#endif
         "AL_SOFT_effect_target"sv,
         "AL_SOFT_events"sv,
         "AL_SOFT_gain_clamp_ex"sv,
+        "AL_SOFTX_half_i24_formats"sv,
         "AL_SOFTX_hold_on_disconnect"sv,
         "AL_SOFT_loop_points"sv,
         "AL_SOFTX_map_buffer"sv,
         "AL_SOFT_MSADPCM"sv,
         "AL_SOFT_source_latency"sv,
         "AL_SOFT_source_length"sv,
+        "AL_SOFTX_source_low_watermark"sv,
         "AL_SOFTX_source_panning"sv,
+        "AL_SOFTX_source_ramp"sv,
         "AL_SOFT_source_resampler"sv,
         "AL_SOFT_source_spatialize"sv,
         "AL_SOFT_source_start_delay"sv,
+        "AL_SOFTX_source_status_batch"sv,
         "AL_SOFT_UHJ"sv,
         "AL_SOFT_UHJ_ex"sv,
     };
@@ -236,6 +244,9 @@ void ALCcontext::init()
 
     allocVoices(256);
     mActiveVoiceCount.store(64, std::memory_order_relaxed);
+
+    preallocVoices();
+    preallocEffectSlots();
 }
 
 void ALCcontext::deinit()
@@ -340,6 +351,18 @@ ALenum ALCcontext::eax_eax_set(
 
     eax_initialize();
 
+    /* An immediate source change with nothing else pending only needs that
+     * source committed, rather than the context, FX slots, and all sources.
+     */
+    const auto commit_now = !call.is_deferred() && !mDeferUpdates;
+    if(commit_now && !mEaxNeedsCommit
+        && call.get_property_set_id() == EaxCallPropertySetId::source)
+    {
+        eax_dispatch_source(call, true);
+        mEaxCommitsAvoided.fetch_add(1u, std::memory_order_relaxed);
+        return AL_NO_ERROR;
+    }
+
     switch(call.get_property_set_id())
     {
     case EaxCallPropertySetId::context:
@@ -350,19 +373,23 @@ ALenum ALCcontext::eax_eax_set(
         eax_dispatch_fx_slot(call);
         break;
     case EaxCallPropertySetId::source:
-        eax_dispatch_source(call);
+        eax_dispatch_source(call, false);
         break;
     default:
         eax_fail_unknown_property_set_id();
     }
     mEaxNeedsCommit = true;
 
-    if(!call.is_deferred())
+    /* When updates are deferred, the commit is left for when they're applied
+     * so a batch of changes only commits once.
+     */
+    if(commit_now)
     {
         eaxCommit();
-        if(!mDeferUpdates)
-            applyAllUpdates();
+        applyAllUpdates();
     }
+    else if(!call.is_deferred())
+        mEaxCommitsAvoided.fetch_add(1u, std::memory_order_relaxed);
 
     return AL_NO_ERROR;
 }
@@ -394,7 +421,7 @@ ALenum ALCcontext::eax_eax_get(
         eax_dispatch_fx_slot(call);
         break;
     case EaxCallPropertySetId::source:
-        eax_dispatch_source(call);
+        eax_dispatch_source(call, false);
         break;
     default:
         eax_fail_unknown_property_set_id();
@@ -616,7 +643,7 @@ void ALCcontext::eax_dispatch_fx_slot(const EaxCall& call)
     }
 }
 
-void ALCcontext::eax_dispatch_source(const EaxCall& call)
+void ALCcontext::eax_dispatch_source(const EaxCall& call, const bool commit)
 {
     const auto source_id = call.get_property_al_name();
     std::lock_guard<std::mutex> source_lock{mSourceLock};
@@ -626,6 +653,8 @@ void ALCcontext::eax_dispatch_source(const EaxCall& call)
         eax_fail("Source not found.");
 
     source->eaxDispatch(call);
+    if(commit)
+        source->eaxCommitAndUpdate();
 }
 
 void ALCcontext::eax_get_misc(const EaxCall& call)
@@ -260,6 +260,12 @@ public:
     bool eaxNeedsCommit() const noexcept { return mEaxNeedsCommit; }
     void eaxCommit();
 
+    /* The number of full EAX commits that were skipped, either by committing a
+     * single source or by leaving the commit for the next batch of updates.
+     */
+    auto eaxCommitsAvoided() const noexcept -> unsigned int
+    { return mEaxCommitsAvoided.load(std::memory_order_relaxed); }
+
     void eaxCommitFxSlots()
     { mEaxFxSlots.commit(); }
 
@@ -439,6 +445,7 @@ private:
 
     int mEaxVersion{}; // Current EAX version.
     bool mEaxNeedsCommit{};
+    std::atomic<unsigned int> mEaxCommitsAvoided{0u};
     std::bitset<eax_dirty_bit_count> mEaxDf; // Dirty flags for the current EAX version.
     Eax5State mEax123{}; // EAX1/EAX2/EAX3 state.
     Eax4State mEax4{}; // EAX4 state.
@@ -524,7 +531,7 @@ private:
     void eax_set_defaults();
 
     void eax_dispatch_fx_slot(const EaxCall& call);
-    void eax_dispatch_source(const EaxCall& call);
+    void eax_dispatch_source(const EaxCall& call, const bool commit);
 
     void eax_get_misc(const EaxCall& call);
     void eax4_get(const EaxCall& call, const Eax4Props& props);
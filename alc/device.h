@@ -4,6 +4,7 @@
 #include "config.h"
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -52,6 +53,26 @@ struct Device final : public ALCdevice, al::intrusive_ref<al::Device>, DeviceBas
     // Maximum number of slots that can be created
     uint AuxiliaryEffectSlotMax{};
 
+    /* The backend format requested with the last reset. If a later reset
+     * requests the same format, the backend doesn't need to be reset.
+     */
+    struct FormatRequest {
+        uint mSampleRate{};
+        uint mUpdateSize{};
+        uint mBufferSize{};
+        DevFmtChannels mChannels{};
+        DevFmtType mType{};
+        uint mAmbiOrder{};
+        DevAmbiLayout mAmbiLayout{};
+        DevAmbiScaling mAmbiScale{};
+        bool mFrequencyRequest{};
+        bool mChannelsRequest{};
+        bool mSampleTypeRequest{};
+
+        bool operator==(const FormatRequest&) const noexcept = default;
+    };
+    std::optional<FormatRequest> mLastFormatRequest;
+
     std::string mHrtfName;
     std::vector<std::string> mHrtfList;
     ALCenum mHrtfStatus{ALC_FALSE};
@@ -95,6 +116,11 @@ struct Device final : public ALCdevice, al::intrusive_ref<al::Device>, DeviceBas
     std::unordered_map<ALuint,std::string> mEffectNames;
     std::unordered_map<ALuint,std::string> mFilterNames;
 
+    /* Captured samples held for alcCaptureAcquireSamplesSOFT, when the
+     * backend has no ring buffer to expose directly.
+     */
+    std::vector<std::byte> mCaptureStaging;
+
     std::string mVendorOverride;
     std::string mVersionOverride;
     std::string mRendererOverride;
@@ -112,6 +112,8 @@ void LoadSamples(const std::span<float> dst, const std::byte *src, const size_t
     HANDLE_FMT(FmtDouble);
     HANDLE_FMT(FmtMulaw);
     HANDLE_FMT(FmtAlaw);
+    HANDLE_FMT(FmtHalf);
+    HANDLE_FMT(FmtInt24);
     /* FIXME: Handle ADPCM decoding here. */
     case FmtIMA4:
     case FmtMSADPCM:
@@ -269,10 +271,23 @@ void ConvolutionState::NormalMix(const std::span<FloatBufferLine> samplesOut,
 void ConvolutionState::UpsampleMix(const std::span<FloatBufferLine> samplesOut,
     const size_t samplesToDo)
 {
+    auto splitters = std::array<BandSplitter*,MaxAmbiChannels>{};
+    auto samples = std::array<float*,MaxAmbiChannels>{};
+    auto hfscales = std::array<float,MaxAmbiChannels>{};
+    auto lfscales = std::array<float,MaxAmbiChannels>{};
+    for(size_t c{0};c < mChans.size();++c)
+    {
+        splitters[c] = &mChans[c].mFilter;
+        samples[c] = mChans[c].mBuffer.data();
+        hfscales[c] = mChans[c].mHfScale;
+        lfscales[c] = mChans[c].mLfScale;
+    }
+    BandSplitter::processScaleGroup(std::span{splitters}.first(mChans.size()), samples,
+        hfscales, lfscales, samplesToDo);
+
     for(auto &chan : mChans)
     {
         const auto src = std::span{chan.mBuffer}.first(samplesToDo);
-        chan.mFilter.processScale(src, chan.mHfScale, chan.mLfScale);
         MixSamples(src, samplesOut, chan.Current, chan.Target, samplesToDo, 0);
     }
 }
@@ -30,7 +30,6 @@
 #include <variant>
 
 #include "alc/effects/base.h"
-#include "alcomplex.h"
 #include "alnumeric.h"
 #include "core/ambidefs.h"
 #include "core/bufferline.h"
@@ -41,6 +40,7 @@
 #include "core/mixer.h"
 #include "core/mixer/defs.h"
 #include "intrusive_ptr.h"
+#include "pffft.h"
 
 
 struct BufferStorage;
@@ -48,7 +48,7 @@ struct BufferStorage;
 namespace {
 
 using uint = unsigned int;
-using complex_d = std::complex<double>;
+using complex_f = std::complex<float>;
 
 constexpr size_t HilSize{1024};
 constexpr size_t HilHalfSize{HilSize >> 1};
@@ -59,7 +59,7 @@ constexpr size_t HilStep{HilSize / OversampleFactor};
 
 /* Define a Hann window, used to filter the HIL input and output. */
 struct Windower {
-    alignas(16) std::array<double,HilSize> mData{};
+    alignas(16) std::array<float,HilSize> mData{};
 
     Windower()
     {
@@ -68,12 +68,35 @@ struct Windower {
         {
             static constexpr auto scale = std::numbers::pi / double{HilSize};
             const auto val = std::sin((static_cast<double>(i)+0.5) * scale);
-            mData[i] = mData[HilSize-1-i] = val * val;
+            mData[i] = mData[HilSize-1-i] = static_cast<float>(val * val);
         }
     }
 };
 const Windower gWindow{};
 
+/* The frequency-domain response of the Hilbert transform, in PFFFT's internal
+ * z-domain order. This shifts the phase of all positive frequencies by +90
+ * degrees and removes DC and Nyquist, so the inverse FFT of the product with
+ * the FFT'd real signal is the imaginary component of its analytic signal.
+ * The response is scaled by the FFT length so the iFFT result is normalized.
+ */
+struct HilbertFilter {
+    PFFFTSetup mFft;
+    alignas(16) std::array<float,HilSize> mResponse{};
+
+    HilbertFilter() : mFft{HilSize, PFFFT_REAL}
+    {
+        /* The first pair holds DC and Nyquist, which are left at 0. The
+         * remaining pairs are the complex bins, each set to +j.
+         */
+        alignas(16) std::array<float,HilSize> fftTmp{};
+        for(size_t i{1};i < HilHalfSize;++i)
+            fftTmp[i*2 + 1] = 1.0f / float{HilSize};
+        mFft.zreorder(fftTmp.data(), mResponse.data(), PFFFT_BACKWARD);
+    }
+};
+const HilbertFilter gHilbert{};
+
 
 struct FshifterState final : public EffectState {
     /* Effect parameters */
@@ -81,14 +104,21 @@ struct FshifterState final : public EffectState {
     size_t mPos{};
     std::array<uint,2> mPhaseStep{};
     std::array<uint,2> mPhase{};
-    std::array<double,2> mSign{};
+    std::array<float,2> mSign{};
 
     /* Effects buffers */
-    std::array<double,HilSize> mInFIFO{};
-    std::array<complex_d,HilStep> mOutFIFO{};
-    std::array<complex_d,HilSize> mOutputAccum{};
-    std::array<complex_d,HilSize> mAnalytic{};
-    std::array<complex_d,BufferLineSize> mOutdata{};
+    std::array<float,HilSize> mInFIFO{};
+    std::array<complex_f,HilStep> mOutFIFO{};
+    std::array<complex_f,HilSize> mOutputAccum{};
+    std::array<complex_f,BufferLineSize> mOutdata{};
+
+    /* The windowed input (the real component of the analytic signal), and
+     * its Hilbert transform (the imaginary component).
+     */
+    alignas(16) std::array<float,HilSize> mAnalyticReal{};
+    alignas(16) std::array<float,HilSize> mAnalyticImag{};
+    alignas(16) std::array<float,HilSize> mFftBuffer{};
+    alignas(16) std::array<float,HilSize> mFftWorkBuffer{};
 
     alignas(16) FloatBufferLine mBufferOut{};
 
@@ -115,11 +145,12 @@ void FshifterState::deviceUpdate(const DeviceBase*, const BufferStorage*)
 
     mPhaseStep.fill(0u);
     mPhase.fill(0u);
-    mSign.fill(1.0);
-    mInFIFO.fill(0.0);
-    mOutFIFO.fill(complex_d{});
-    mOutputAccum.fill(complex_d{});
-    mAnalytic.fill(complex_d{});
+    mSign.fill(1.0f);
+    mInFIFO.fill(0.0f);
+    mOutFIFO.fill(complex_f{});
+    mOutputAccum.fill(complex_f{});
+    mAnalyticReal.fill(0.0f);
+    mAnalyticImag.fill(0.0f);
 
     for(auto &gain : mGains)
     {
@@ -140,10 +171,10 @@ void FshifterState::update(const ContextBase *context, const EffectSlot *slot,
     switch(props.LeftDirection)
     {
     case FShifterDirection::Down:
-        mSign[0] = -1.0;
+        mSign[0] = -1.0f;
         break;
     case FShifterDirection::Up:
-        mSign[0] = 1.0;
+        mSign[0] = 1.0f;
         break;
     case FShifterDirection::Off:
         mPhase[0]     = 0;
@@ -154,10 +185,10 @@ void FshifterState::update(const ContextBase *context, const EffectSlot *slot,
     switch(props.RightDirection)
     {
     case FShifterDirection::Down:
-        mSign[1] = -1.0;
+        mSign[1] = -1.0f;
         break;
     case FShifterDirection::Up:
-        mSign[1] = 1.0;
+        mSign[1] = 1.0f;
         break;
     case FShifterDirection::Off:
         mPhase[1]     = 0;
@@ -202,36 +233,53 @@ void FshifterState::process(const size_t samplesToDo,
 
         /* Real signal windowing and store in Analytic buffer */
         for(size_t src{mPos}, k{0u};src < HilSize;++src,++k)
-            mAnalytic[k] = mInFIFO[src]*gWindow.mData[k];
+            mAnalyticReal[k] = mInFIFO[src]*gWindow.mData[k];
         for(size_t src{0u}, k{HilSize-mPos};src < mPos;++src,++k)
-            mAnalytic[k] = mInFIFO[src]*gWindow.mData[k];
-
-        /* Processing signal by Discrete Hilbert Transform (analytical signal). */
-        complex_hilbert(mAnalytic);
+            mAnalyticReal[k] = mInFIFO[src]*gWindow.mData[k];
+
+        /* Processing signal by Discrete Hilbert Transform (analytical signal).
+         * The real component is the windowed input as-is, and the imaginary
+         * component is the inverse FFT of the input's FFT with the Hilbert
+         * response applied.
+         */
+        gHilbert.mFft.transform(mAnalyticReal.data(), mFftBuffer.data(), mFftWorkBuffer.data(),
+            PFFFT_FORWARD);
+        mAnalyticImag.fill(0.0f);
+        gHilbert.mFft.zconvolve_accumulate(mFftBuffer.data(), gHilbert.mResponse.data(),
+            mAnalyticImag.data());
+        gHilbert.mFft.transform(mAnalyticImag.data(), mAnalyticImag.data(),
+            mFftWorkBuffer.data(), PFFFT_BACKWARD);
 
         /* Windowing and add to output accumulator */
+        static constexpr auto scale = 2.0f / float{OversampleFactor};
         for(size_t dst{mPos}, k{0u};dst < HilSize;++dst,++k)
-            mOutputAccum[dst] += 2.0/OversampleFactor*gWindow.mData[k]*mAnalytic[k];
+        {
+            const auto gain = scale * gWindow.mData[k];
+            mOutputAccum[dst] += complex_f{gain*mAnalyticReal[k], gain*mAnalyticImag[k]};
+        }
         for(size_t dst{0u}, k{HilSize-mPos};dst < mPos;++dst,++k)
-            mOutputAccum[dst] += 2.0/OversampleFactor*gWindow.mData[k]*mAnalytic[k];
+        {
+            const auto gain = scale * gWindow.mData[k];
+            mOutputAccum[dst] += complex_f{gain*mAnalyticReal[k], gain*mAnalyticImag[k]};
+        }
 
         /* Copy out the accumulated result, then clear for the next iteration. */
         std::copy_n(mOutputAccum.cbegin() + mPos, HilStep, mOutFIFO.begin());
-        std::fill_n(mOutputAccum.begin() + mPos, HilStep, complex_d{});
+        std::fill_n(mOutputAccum.begin() + mPos, HilStep, complex_f{});
     }
 
     /* Process frequency shifter using the analytic signal obtained. */
     for(size_t c{0};c < 2;++c)
     {
-        const double sign{mSign[c]};
+        const float sign{mSign[c]};
         const uint phase_step{mPhaseStep[c]};
         uint phase_idx{mPhase[c]};
         std::transform(mOutdata.cbegin(), mOutdata.cbegin()+samplesToDo, mBufferOut.begin(),
-            [&phase_idx,phase_step,sign](const complex_d &in) -> float
+            [&phase_idx,phase_step,sign](const complex_f &in) -> float
             {
-                const double phase{phase_idx * (std::numbers::pi*2.0 / MixerFracOne)};
-                const auto out = static_cast<float>(in.real()*std::cos(phase) +
-                    in.imag()*std::sin(phase)*sign);
+                static constexpr auto scale = std::numbers::pi_v<float>*2.0f / float{MixerFracOne};
+                const auto phase = static_cast<float>(phase_idx) * scale;
+                const auto out = in.real()*std::cos(phase) + in.imag()*std::sin(phase)*sign;
 
                 phase_idx += phase_step;
                 phase_idx &= MixerFracMask;
@@ -19,16 +19,23 @@
  */
 
 #include "config.h"
+#include "config_simd.h"
 
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <complex>
 #include <cstdlib>
+#include <limits>
 #include <numbers>
 #include <span>
 #include <variant>
 
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "alc/effects/base.h"
 #include "alnumeric.h"
 #include "core/ambidefs.h"
@@ -48,7 +55,6 @@ struct ContextBase;
 namespace {
 
 using uint = unsigned int;
-using complex_f = std::complex<float>;
 
 constexpr size_t StftSize{1024};
 constexpr size_t StftHalfSize{StftSize >> 1};
@@ -75,10 +81,357 @@ struct Windower {
 const Windower gWindow{};
 
 
-struct FrequencyBin {
-    float Magnitude;
-    float FreqBin;
-};
+/* The number of frequency bins analyzed and synthesized, padded to a multiple
+ * of 4 so the per-bin loops don't need a remainder.
+ */
+constexpr size_t BinCount{StftHalfSize+1};
+constexpr size_t BinCountPadded{(BinCount+3) & ~3_uz};
+
+/* Cycle offset per update expected of each frequency bin (bin 0 is none, bin 1
+ * is x1, bin 2 is x2, etc).
+ */
+constexpr auto ExpectedCycles = std::numbers::pi_v<float>*2.0f / OversampleFactor;
+
+/* Polynomial coefficients for approximating atan(x)/x with 0 <= x <= 1 (in
+ * terms of x^2), and sin(x)/x and cos(x) with -pi/2 <= x <= pi/2 (in terms of
+ * x^2). These are accurate to within a few float ULPs, and unlike the standard
+ * library functions, can be evaluated for multiple bins at once.
+ */
+constexpr auto AtanCoeffs = std::array{1.0f, -0.3333314528f, 0.1999355085f, -0.1420889944f,
+    0.1065626393f, -0.0752896400f, 0.0429096138f, -0.0161657367f, 0.0028662257f};
+constexpr auto SinCoeffs = std::array{1.0f, -1.0f/6.0f, 1.0f/120.0f, -1.0f/5040.0f,
+    1.0f/362880.0f, -1.0f/39916800.0f};
+constexpr auto CosCoeffs = std::array{1.0f, -1.0f/2.0f, 1.0f/24.0f, -1.0f/720.0f,
+    1.0f/40320.0f, -1.0f/3628800.0f, 1.0f/479001600.0f};
+
+/* Bin offsets for a group of 4 bins, based on the bin index modulo the
+ * oversampling factor.
+ */
+static_assert(OversampleFactor == 8, "Bin offsets need updating for the oversample factor");
+alignas(16) constexpr auto BinOffsets = std::array{
+    std::array{0.0f, 1.0f, 2.0f, 3.0f}, std::array{4.0f, 5.0f, 6.0f, 7.0f}};
+
+
+#if HAVE_SSE_INTRINSICS
+
+template<size_t N>
+auto vpoly(const __m128 x, const std::array<float,N> &coeffs) noexcept -> __m128
+{
+    auto ret = _mm_set1_ps(coeffs.back());
+    for(size_t i{N-1};i > 0;--i)
+        ret = _mm_add_ps(_mm_mul_ps(ret, x), _mm_set1_ps(coeffs[i-1]));
+    return ret;
+}
+
+auto vatan2(const __m128 y, const __m128 x) noexcept -> __m128
+{
+    const auto signmask = _mm_set1_ps(-0.0f);
+    const auto ax = _mm_andnot_ps(signmask, x);
+    const auto ay = _mm_andnot_ps(signmask, y);
+    /* Avoid a 0/0 division for silent bins, which results in an angle of 0. */
+    const auto a = _mm_div_ps(_mm_min_ps(ax, ay),
+        _mm_max_ps(_mm_max_ps(ax, ay), _mm_set1_ps(std::numeric_limits<float>::min())));
+    auto r = _mm_mul_ps(a, vpoly(_mm_mul_ps(a, a), AtanCoeffs));
+
+    auto mask = _mm_cmpgt_ps(ay, ax);
+    r = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(std::numbers::pi_v<float>*0.5f), r)),
+        _mm_andnot_ps(mask, r));
+    mask = _mm_cmplt_ps(x, _mm_setzero_ps());
+    r = _mm_or_ps(_mm_and_ps(mask, _mm_sub_ps(_mm_set1_ps(std::numbers::pi_v<float>), r)),
+        _mm_andnot_ps(mask, r));
+    return _mm_or_ps(r, _mm_and_ps(signmask, y));
+}
+
+void vsincos(const __m128 x, __m128 &sine, __m128 &cosine) noexcept
+{
+    /* Reflect around +/-pi/2 to keep the polynomials within +/-pi/2, which
+     * flips the sign of the cosine.
+     */
+    const auto signmask = _mm_set1_ps(-0.0f);
+    const auto reflect = _mm_cmpgt_ps(_mm_andnot_ps(signmask, x),
+        _mm_set1_ps(std::numbers::pi_v<float>*0.5f));
+    const auto pi = _mm_or_ps(_mm_set1_ps(std::numbers::pi_v<float>), _mm_and_ps(signmask, x));
+    const auto r = _mm_or_ps(_mm_and_ps(reflect, _mm_sub_ps(pi, x)), _mm_andnot_ps(reflect, x));
+    const auto r2 = _mm_mul_ps(r, r);
+    sine = _mm_mul_ps(r, vpoly(r2, SinCoeffs));
+    cosine = _mm_xor_ps(vpoly(r2, CosCoeffs), _mm_and_ps(reflect, signmask));
+}
+
+/* Wraps phase values, normalized from pi, to between -1 and +1. */
+auto vwrap_phase(const __m128 phase) noexcept -> __m128
+{
+    /* qpd + (qpd%2), with the remainder having the sign of qpd. */
+    const auto qpd = _mm_cvttps_epi32(phase);
+    const auto sign = _mm_srai_epi32(qpd, 31);
+    const auto odd = _mm_and_si128(qpd, _mm_set1_epi32(1));
+    const auto adj = _mm_add_epi32(qpd, _mm_sub_epi32(_mm_xor_si128(odd, sign), sign));
+    return _mm_sub_ps(phase, _mm_cvtepi32_ps(adj));
+}
+
+#elif HAVE_NEON
+
+template<size_t N>
+auto vpoly(const float32x4_t x, const std::array<float,N> &coeffs) noexcept -> float32x4_t
+{
+    auto ret = vdupq_n_f32(coeffs.back());
+    for(size_t i{N-1};i > 0;--i)
+        ret = vmlaq_f32(vdupq_n_f32(coeffs[i-1]), ret, x);
+    return ret;
+}
+
+auto vrecip(const float32x4_t x) noexcept -> float32x4_t
+{
+    /* Refine the reciprocal estimate with two Newton-Raphson steps. */
+    auto ret = vrecpeq_f32(x);
+    ret = vmulq_f32(vrecpsq_f32(x, ret), ret);
+    ret = vmulq_f32(vrecpsq_f32(x, ret), ret);
+    return ret;
+}
+
+auto vsqrt(const float32x4_t x) noexcept -> float32x4_t
+{
+    /* Refine the reciprocal square root estimate with two Newton-Raphson
+     * steps, and multiply with the input (masking out 0 inputs, which would
+     * otherwise be 0*inf).
+     */
+    auto ret = vrsqrteq_f32(x);
+    ret = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, ret), ret), ret);
+    ret = vmulq_f32(vrsqrtsq_f32(vmulq_f32(x, ret), ret), ret);
+    const auto zero = vdupq_n_f32(0.0f);
+    return vbslq_f32(vcgtq_f32(x, zero), vmulq_f32(x, ret), zero);
+}
+
+auto vatan2(const float32x4_t y, const float32x4_t x) noexcept -> float32x4_t
+{
+    const auto signmask = vdupq_n_u32(0x80000000u);
+    const auto ax = vabsq_f32(x);
+    const auto ay = vabsq_f32(y);
+    /* Avoid a 0/0 division for silent bins, which results in an angle of 0. */
+    const auto a = vmulq_f32(vminq_f32(ax, ay),
+        vrecip(vmaxq_f32(vmaxq_f32(ax, ay), vdupq_n_f32(std::numeric_limits<float>::min()))));
+    auto r = vmulq_f32(a, vpoly(vmulq_f32(a, a), AtanCoeffs));
+
+    r = vbslq_f32(vcgtq_f32(ay, ax), vsubq_f32(vdupq_n_f32(std::numbers::pi_v<float>*0.5f), r),
+        r);
+    r = vbslq_f32(vcltq_f32(x, vdupq_n_f32(0.0f)),
+        vsubq_f32(vdupq_n_f32(std::numbers::pi_v<float>), r), r);
+    return vbslq_f32(signmask, y, r);
+}
+
+void vsincos(const float32x4_t x, float32x4_t &sine, float32x4_t &cosine) noexcept
+{
+    /* Reflect around +/-pi/2 to keep the polynomials within +/-pi/2, which
+     * flips the sign of the cosine.
+     */
+    const auto signmask = vdupq_n_u32(0x80000000u);
+    const auto reflect = vcgtq_f32(vabsq_f32(x), vdupq_n_f32(std::numbers::pi_v<float>*0.5f));
+    const auto pi = vbslq_f32(signmask, x, vdupq_n_f32(std::numbers::pi_v<float>));
+    const auto r = vbslq_f32(reflect, vsubq_f32(pi, x), x);
+    const auto r2 = vmulq_f32(r, r);
+    sine = vmulq_f32(r, vpoly(r2, SinCoeffs));
+    cosine = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(vpoly(r2, CosCoeffs)),
+        vandq_u32(reflect, signmask)));
+}
+
+/* Wraps phase values, normalized from pi, to between -1 and +1. */
+auto vwrap_phase(const float32x4_t phase) noexcept -> float32x4_t
+{
+    /* qpd + (qpd%2), with the remainder having the sign of qpd. */
+    const auto qpd = vcvtq_s32_f32(phase);
+    const auto sign = vshrq_n_s32(qpd, 31);
+    const auto odd = vandq_s32(qpd, vdupq_n_s32(1));
+    const auto adj = vaddq_s32(qpd, vsubq_s32(veorq_s32(odd, sign), sign));
+    return vsubq_f32(phase, vcvtq_f32_s32(adj));
+}
+
+#else
+
+template<size_t N>
+auto poly(const float x, const std::array<float,N> &coeffs) noexcept -> float
+{
+    auto ret = coeffs.back();
+    for(size_t i{N-1};i > 0;--i)
+        ret = ret*x + coeffs[i-1];
+    return ret;
+}
+
+auto fast_atan2(const float y, const float x) noexcept -> float
+{
+    const auto ax = std::abs(x);
+    const auto ay = std::abs(y);
+    /* Avoid a 0/0 division for silent bins, which results in an angle of 0. */
+    const auto a = std::min(ax, ay) / std::max(std::max(ax, ay),
+        std::numeric_limits<float>::min());
+    auto r = a * poly(a*a, AtanCoeffs);
+    if(ay > ax) r = std::numbers::pi_v<float>*0.5f - r;
+    if(x < 0.0f) r = std::numbers::pi_v<float> - r;
+    return std::copysign(r, y);
+}
+
+void fast_sincos(const float x, float &sine, float &cosine) noexcept
+{
+    /* Reflect around +/-pi/2 to keep the polynomials within +/-pi/2, which
+     * flips the sign of the cosine.
+     */
+    const auto reflect = std::abs(x) > std::numbers::pi_v<float>*0.5f;
+    const auto r = reflect ? std::copysign(std::numbers::pi_v<float>, x) - x : x;
+    const auto r2 = r*r;
+    sine = r * poly(r2, SinCoeffs);
+    cosine = reflect ? -poly(r2, CosCoeffs) : poly(r2, CosCoeffs);
+}
+
+/* Wraps a phase value, normalized from pi, to between -1 and +1. */
+auto wrap_phase(const float phase) noexcept -> float
+{
+    const int qpd{float2int(phase)};
+    return phase - static_cast<float>(qpd + (qpd%2));
+}
+#endif
+
+
+/* Analyzes the frequency bins, calculating the magnitude and frequency bin
+ * target of each, and updating the last phase.
+ */
+void AnalyzeBins(const std::span<const float,BinCountPadded> binreal,
+    const std::span<const float,BinCountPadded> binimag,
+    const std::span<float,BinCountPadded> lastphase, const std::span<float,BinCountPadded> mags,
+    const std::span<float,BinCountPadded> freqs)
+{
+    /* For each bin, compute the phase difference from the last update and
+     * subtract the expected phase difference for the bin. When oversampling,
+     * the expected per-update offset increments by 1/OversampleFactor for
+     * every frequency bin. So, the offset wraps every 'OversampleFactor' bin.
+     *
+     * The delta is then normalized from pi and wrapped between -1 and +1, to
+     * get the deviation from the bin frequency (-0.5 to +0.5, accounting for
+     * oversampling). We don't need the "true frequency" since it's a linear
+     * relationship with the bin.
+     */
+#if HAVE_SSE_INTRINSICS
+    const auto expected4 = _mm_set1_ps(ExpectedCycles);
+    const auto scale4 = _mm_set1_ps(std::numbers::inv_pi_v<float>);
+    const auto deviation4 = _mm_set1_ps(0.5f * OversampleFactor);
+    for(size_t k{0u};k < BinCountPadded;k+=4)
+    {
+        const auto re = _mm_load_ps(&binreal[k]);
+        const auto im = _mm_load_ps(&binimag[k]);
+        _mm_store_ps(&mags[k], _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im))));
+
+        const auto phase = vatan2(im, re);
+        const auto offset = _mm_load_ps(BinOffsets[(k/4)&1].data());
+        auto tmp = _mm_sub_ps(_mm_sub_ps(phase, _mm_load_ps(&lastphase[k])),
+            _mm_mul_ps(offset, expected4));
+        _mm_store_ps(&lastphase[k], phase);
+
+        tmp = _mm_mul_ps(vwrap_phase(_mm_mul_ps(tmp, scale4)), deviation4);
+        const auto bin = _mm_add_ps(_mm_set1_ps(static_cast<float>(k)),
+            _mm_load_ps(BinOffsets[0].data()));
+        _mm_store_ps(&freqs[k], _mm_add_ps(bin, tmp));
+    }
+
+#elif HAVE_NEON
+
+    const auto expected4 = vdupq_n_f32(ExpectedCycles);
+    const auto scale4 = vdupq_n_f32(std::numbers::inv_pi_v<float>);
+    const auto deviation4 = vdupq_n_f32(0.5f * OversampleFactor);
+    for(size_t k{0u};k < BinCountPadded;k+=4)
+    {
+        const auto re = vld1q_f32(&binreal[k]);
+        const auto im = vld1q_f32(&binimag[k]);
+        vst1q_f32(&mags[k], vsqrt(vmlaq_f32(vmulq_f32(re, re), im, im)));
+
+        const auto phase = vatan2(im, re);
+        const auto offset = vld1q_f32(BinOffsets[(k/4)&1].data());
+        auto tmp = vmlsq_f32(vsubq_f32(phase, vld1q_f32(&lastphase[k])), offset, expected4);
+        vst1q_f32(&lastphase[k], phase);
+
+        tmp = vmulq_f32(vwrap_phase(vmulq_f32(tmp, scale4)), deviation4);
+        const auto bin = vaddq_f32(vdupq_n_f32(static_cast<float>(k)),
+            vld1q_f32(BinOffsets[0].data()));
+        vst1q_f32(&freqs[k], vaddq_f32(bin, tmp));
+    }
+
+#else
+
+    for(size_t k{0u};k < BinCountPadded;++k)
+    {
+        const float re{binreal[k]}, im{binimag[k]};
+        mags[k] = std::sqrt(re*re + im*im);
+
+        const float phase{fast_atan2(im, re)};
+        const auto bin_offset = static_cast<float>(k % OversampleFactor);
+        float tmp{(phase - lastphase[k]) - bin_offset*ExpectedCycles};
+        lastphase[k] = phase;
+
+        tmp = wrap_phase(tmp * std::numbers::inv_pi_v<float>) * (0.5f * OversampleFactor);
+        freqs[k] = static_cast<float>(k) + tmp;
+    }
+#endif
+}
+
+/* Synthesizes the frequency bins from the given magnitudes and frequency bin
+ * targets, updating the phase sum.
+ */
+void SynthesizeBins(const std::span<const float,BinCountPadded> mags,
+    const std::span<const float,BinCountPadded> freqs,
+    const std::span<float,BinCountPadded> sumphase, const std::span<float,BinCountPadded> binreal,
+    const std::span<float,BinCountPadded> binimag)
+{
+    /* For each bin, calculate the actual delta phase for the bin's target
+     * frequency bin, and accumulate it to get the actual bin phase. The sum is
+     * wrapped between -pi and +pi; if left to grow indefinitely, it would lose
+     * precision and produce less exact phase over time.
+     */
+#if HAVE_SSE_INTRINSICS
+    const auto expected4 = _mm_set1_ps(ExpectedCycles);
+    const auto scale4 = _mm_set1_ps(std::numbers::inv_pi_v<float>);
+    const auto pi4 = _mm_set1_ps(std::numbers::pi_v<float>);
+    for(size_t k{0u};k < BinCountPadded;k+=4)
+    {
+        auto tmp = _mm_add_ps(_mm_load_ps(&sumphase[k]),
+            _mm_mul_ps(_mm_load_ps(&freqs[k]), expected4));
+        tmp = _mm_mul_ps(vwrap_phase(_mm_mul_ps(tmp, scale4)), pi4);
+        _mm_store_ps(&sumphase[k], tmp);
+
+        auto sine = __m128{}, cosine = __m128{};
+        vsincos(tmp, sine, cosine);
+        const auto mag = _mm_load_ps(&mags[k]);
+        _mm_store_ps(&binreal[k], _mm_mul_ps(mag, cosine));
+        _mm_store_ps(&binimag[k], _mm_mul_ps(mag, sine));
+    }
+
+#elif HAVE_NEON
+
+    const auto expected4 = vdupq_n_f32(ExpectedCycles);
+    const auto scale4 = vdupq_n_f32(std::numbers::inv_pi_v<float>);
+    const auto pi4 = vdupq_n_f32(std::numbers::pi_v<float>);
+    for(size_t k{0u};k < BinCountPadded;k+=4)
+    {
+        auto tmp = vmlaq_f32(vld1q_f32(&sumphase[k]), vld1q_f32(&freqs[k]), expected4);
+        tmp = vmulq_f32(vwrap_phase(vmulq_f32(tmp, scale4)), pi4);
+        vst1q_f32(&sumphase[k], tmp);
+
+        auto sine = vdupq_n_f32(0.0f), cosine = vdupq_n_f32(0.0f);
+        vsincos(tmp, sine, cosine);
+        const auto mag = vld1q_f32(&mags[k]);
+        vst1q_f32(&binreal[k], vmulq_f32(mag, cosine));
+        vst1q_f32(&binimag[k], vmulq_f32(mag, sine));
+    }
+
+#else
+
+    for(size_t k{0u};k < BinCountPadded;++k)
+    {
+        const float tmp{sumphase[k] + freqs[k]*ExpectedCycles};
+        sumphase[k] = wrap_phase(tmp * std::numbers::inv_pi_v<float>) * std::numbers::pi_v<float>;
+
+        float sine{}, cosine{};
+        fast_sincos(sumphase[k], sine, cosine);
+        binreal[k] = mags[k] * cosine;
+        binimag[k] = mags[k] * sine;
+    }
+#endif
+}
 
 
 struct PshifterState final : public EffectState {
@@ -90,16 +443,25 @@ struct PshifterState final : public EffectState {
 
     /* Effects buffers */
     std::array<float,StftSize> mFIFO{};
-    std::array<float,StftHalfSize+1> mLastPhase{};
-    std::array<float,StftHalfSize+1> mSumPhase{};
+    alignas(16) std::array<float,BinCountPadded> mLastPhase{};
+    alignas(16) std::array<float,BinCountPadded> mSumPhase{};
     std::array<float,StftSize> mOutputAccum{};
 
     PFFFTSetup mFft;
     alignas(16) std::array<float,StftSize> mFftBuffer{};
     alignas(16) std::array<float,StftSize> mFftWorkBuffer{};
 
-    std::array<FrequencyBin,StftHalfSize+1> mAnalysisBuffer{};
-    std::array<FrequencyBin,StftHalfSize+1> mSynthesisBuffer{};
+    /* The frequency-domain bins, as separate real and imaginary parts. */
+    alignas(16) std::array<float,BinCountPadded> mBinReal{};
+    alignas(16) std::array<float,BinCountPadded> mBinImag{};
+
+    /* The analyzed and synthesized bins, as separate magnitudes and frequency
+     * bin targets.
+     */
+    alignas(16) std::array<float,BinCountPadded> mAnalysisMag{};
+    alignas(16) std::array<float,BinCountPadded> mAnalysisFreq{};
+    alignas(16) std::array<float,BinCountPadded> mSynthesisMag{};
+    alignas(16) std::array<float,BinCountPadded> mSynthesisFreq{};
 
     alignas(16) FloatBufferLine mBufferOut{};
 
@@ -128,8 +490,12 @@ void PshifterState::deviceUpdate(const DeviceBase*, const BufferStorage*)
     mSumPhase.fill(0.0f);
     mOutputAccum.fill(0.0f);
     mFftBuffer.fill(0.0f);
-    mAnalysisBuffer.fill(FrequencyBin{});
-    mSynthesisBuffer.fill(FrequencyBin{});
+    mBinReal.fill(0.0f);
+    mBinImag.fill(0.0f);
+    mAnalysisMag.fill(0.0f);
+    mAnalysisFreq.fill(0.0f);
+    mSynthesisMag.fill(0.0f);
+    mSynthesisFreq.fill(0.0f);
 
     mCurrentGains.fill(0.0f);
     mTargetGains.fill(0.0f);
@@ -161,11 +527,6 @@ void PshifterState::process(const size_t samplesToDo,
      * http://blogs.zynaptiq.com/bernsee/pitch-shifting-using-the-ft/
      */
 
-    /* Cycle offset per update expected of each frequency bin (bin 0 is none,
-     * bin 1 is x1, bin 2 is x2, etc).
-     */
-    static constexpr auto expected_cycles = std::numbers::pi_v<float>*2.0f / OversampleFactor;
-
     for(size_t base{0u};base < samplesToDo;)
     {
         const size_t todo{std::min(StftStep-mCount, samplesToDo-base)};
@@ -196,51 +557,26 @@ void PshifterState::process(const size_t samplesToDo,
             PFFFT_FORWARD);
 
         /* Analyze the obtained data. Since the real FFT is symmetric, only
-         * StftHalfSize+1 samples are needed.
+         * StftHalfSize+1 samples are needed. The DC and Nyquist bins are both
+         * real, and packed together in the first complex value.
          */
-        for(size_t k{0u};k < StftHalfSize+1;++k)
+        mBinReal[0] = mFftBuffer[0];
+        mBinImag[0] = 0.0f;
+        for(size_t k{1u};k < StftHalfSize;++k)
         {
-            const auto cplx = (k == 0) ? complex_f{mFftBuffer[0]} :
-                (k == StftHalfSize) ? complex_f{mFftBuffer[1]} :
-                complex_f{mFftBuffer[k*2], mFftBuffer[k*2 + 1]};
-            const float magnitude{std::abs(cplx)};
-            const float phase{std::arg(cplx)};
-
-            /* Compute the phase difference from the last update and subtract
-             * the expected phase difference for this bin.
-             *
-             * When oversampling, the expected per-update offset increments by
-             * 1/OversampleFactor for every frequency bin. So, the offset wraps
-             * every 'OversampleFactor' bin.
-             */
-            const auto bin_offset = static_cast<float>(k % OversampleFactor);
-            float tmp{(phase - mLastPhase[k]) - bin_offset*expected_cycles};
-            /* Store the actual phase for the next update. */
-            mLastPhase[k] = phase;
-
-            /* Normalize from pi, and wrap the delta between -1 and +1. */
-            tmp *= std::numbers::inv_pi_v<float>;
-            int qpd{float2int(tmp)};
-            tmp -= static_cast<float>(qpd + (qpd%2));
-
-            /* Get deviation from bin frequency (-0.5 to +0.5), and account for
-             * oversampling.
-             */
-            tmp *= 0.5f * OversampleFactor;
-
-            /* Compute the k-th partials' frequency bin target and store the
-             * magnitude and frequency bin in the analysis buffer. We don't
-             * need the "true frequency" since it's a linear relationship with
-             * the bin.
-             */
-            mAnalysisBuffer[k].Magnitude = magnitude;
-            mAnalysisBuffer[k].FreqBin = static_cast<float>(k) + tmp;
+            mBinReal[k] = mFftBuffer[k*2 + 0];
+            mBinImag[k] = mFftBuffer[k*2 + 1];
         }
+        mBinReal[StftHalfSize] = mFftBuffer[1];
+        mBinImag[StftHalfSize] = 0.0f;
+
+        AnalyzeBins(mBinReal, mBinImag, mLastPhase, mAnalysisMag, mAnalysisFreq);
 
         /* Shift the frequency bins according to the pitch adjustment,
          * accumulating the magnitudes of overlapping frequency bins.
          */
-        std::fill(mSynthesisBuffer.begin(), mSynthesisBuffer.end(), FrequencyBin{});
+        mSynthesisMag.fill(0.0f);
+        mSynthesisFreq.fill(0.0f);
 
         static constexpr size_t bin_limit{((StftHalfSize+1)<<MixerFracBits) - MixerFracHalf - 1};
         const size_t bin_count{std::min(StftHalfSize+1, bin_limit/mPitchShiftI + 1)};
@@ -252,41 +588,23 @@ void PshifterState::process(const size_t samplesToDo,
              * bin for the one with the dominant magnitude. There might be a
              * better way to handle this, but it's better than last-index-wins.
              */
-            if(mAnalysisBuffer[k].Magnitude > mSynthesisBuffer[j].Magnitude)
-                mSynthesisBuffer[j].FreqBin = mAnalysisBuffer[k].FreqBin * mPitchShift;
-            mSynthesisBuffer[j].Magnitude += mAnalysisBuffer[k].Magnitude;
+            if(mAnalysisMag[k] > mSynthesisMag[j])
+                mSynthesisFreq[j] = mAnalysisFreq[k] * mPitchShift;
+            mSynthesisMag[j] += mAnalysisMag[k];
         }
 
         /* Reconstruct the frequency-domain signal from the adjusted frequency
          * bins.
          */
-        for(size_t k{0u};k < StftHalfSize+1;k++)
-        {
-            /* Calculate the actual delta phase for this bin's target frequency
-             * bin, and accumulate it to get the actual bin phase.
-             */
-            float tmp{mSumPhase[k] + mSynthesisBuffer[k].FreqBin*expected_cycles};
+        SynthesizeBins(mSynthesisMag, mSynthesisFreq, mSumPhase, mBinReal, mBinImag);
 
-            /* Wrap between -pi and +pi for the sum. If mSumPhase is left to
-             * grow indefinitely, it will lose precision and produce less exact
-             * phase over time.
-             */
-            tmp *= std::numbers::inv_pi_v<float>;
-            int qpd{float2int(tmp)};
-            tmp -= static_cast<float>(qpd + (qpd%2));
-            mSumPhase[k] = tmp * std::numbers::pi_v<float>;
-
-            const complex_f cplx{std::polar(mSynthesisBuffer[k].Magnitude, mSumPhase[k])};
-            if(k == 0)
-                mFftBuffer[0] = cplx.real();
-            else if(k == StftHalfSize)
-                mFftBuffer[1] = cplx.real();
-            else
-            {
-                mFftBuffer[k*2 + 0] = cplx.real();
-                mFftBuffer[k*2 + 1] = cplx.imag();
-            }
+        mFftBuffer[0] = mBinReal[0];
+        for(size_t k{1u};k < StftHalfSize;++k)
+        {
+            mFftBuffer[k*2 + 0] = mBinReal[k];
+            mFftBuffer[k*2 + 1] = mBinImag[k];
         }
+        mFftBuffer[1] = mBinReal[StftHalfSize];
 
         /* Apply an inverse FFT to get the time-domain signal, and accumulate
          * for the output with windowing.
@@ -19,6 +19,7 @@
  */
 
 #include "config.h"
+#include "config_simd.h"
 
 #include <algorithm>
 #include <array>
@@ -31,6 +32,12 @@
 #include <numeric>
 #include <span>
 
+#if HAVE_SSE_INTRINSICS
+#include <xmmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "alc/effects/base.h"
 #include "alnumeric.h"
 #include "core/ambidefs.h"
@@ -338,7 +345,49 @@ struct DelayLineU {
         {
             offset &= stride-1;
             size_t td{std::min(stride - offset, count - i)};
-            do {
+#if HAVE_SSE_INTRINSICS
+            const auto half = _mm_set1_ps(0.5f);
+            for(;td >= 4;td-=4)
+            {
+                const auto src0 = _mm_loadu_ps(&in[0][i]);
+                const auto src1 = _mm_loadu_ps(&in[1][i]);
+                const auto src2 = _mm_loadu_ps(&in[2][i]);
+                const auto src3 = _mm_loadu_ps(&in[3][i]);
+                i += 4;
+
+                _mm_storeu_ps(&mLine[0*stride + offset], _mm_mul_ps(
+                    _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(src0, src1), src2), src3), half));
+                _mm_storeu_ps(&mLine[1*stride + offset], _mm_mul_ps(
+                    _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(src1, src0), src2), src3), half));
+                _mm_storeu_ps(&mLine[2*stride + offset], _mm_mul_ps(
+                    _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(src2, src0), src1), src3), half));
+                _mm_storeu_ps(&mLine[3*stride + offset], _mm_mul_ps(
+                    _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(src3, src0), src1), src2), half));
+                offset += 4;
+            }
+#elif HAVE_NEON
+            const auto half = vdupq_n_f32(0.5f);
+            for(;td >= 4;td-=4)
+            {
+                const auto src0 = vld1q_f32(&in[0][i]);
+                const auto src1 = vld1q_f32(&in[1][i]);
+                const auto src2 = vld1q_f32(&in[2][i]);
+                const auto src3 = vld1q_f32(&in[3][i]);
+                i += 4;
+
+                vst1q_f32(&mLine[0*stride + offset], vmulq_f32(
+                    vsubq_f32(vsubq_f32(vsubq_f32(src0, src1), src2), src3), half));
+                vst1q_f32(&mLine[1*stride + offset], vmulq_f32(
+                    vsubq_f32(vsubq_f32(vsubq_f32(src1, src0), src2), src3), half));
+                vst1q_f32(&mLine[2*stride + offset], vmulq_f32(
+                    vsubq_f32(vsubq_f32(vsubq_f32(src2, src0), src1), src3), half));
+                vst1q_f32(&mLine[3*stride + offset], vmulq_f32(
+                    vsubq_f32(vsubq_f32(vsubq_f32(src3, src0), src1), src2), half));
+                offset += 4;
+            }
+#endif
+            for(;td > 0;--td)
+            {
                 const std::array src{in[0][i], in[1][i], in[2][i], in[3][i]};
                 ++i;
 
@@ -353,7 +402,7 @@ struct DelayLineU {
                 mLine[2*stride + offset] = f[2];
                 mLine[3*stride + offset] = f[3];
                 ++offset;
-            } while(--td);
+            }
         }
     }
 };
@@ -386,9 +435,8 @@ struct T60Filter {
     void calcCoeffs(const float length, const float lfDecayTime, const float mfDecayTime,
         const float hfDecayTime, const float lf0norm, const float hf0norm);
 
-    /* Applies the two T60 damping filter sections. */
-    void process(const std::span<float> samples)
-    { DualBiquad{HFFilter, LFFilter}.process(samples, samples); }
+    /* Gets the two T60 damping filter sections. */
+    [[nodiscard]] auto getFilter() noexcept -> DualBiquad { return DualBiquad{HFFilter, LFFilter}; }
 
     void clear() noexcept { HFFilter.clear(); LFFilter.clear(); }
 };
@@ -489,6 +537,7 @@ struct ReverbPipeline {
     struct FilterPair {
         BiquadFilter Lp;
         BiquadFilter Hp;
+        [[nodiscard]] auto getFilter() noexcept -> DualBiquad { return DualBiquad{Lp, Hp}; }
         void clear() noexcept { Lp.clear(); Hp.clear(); }
     };
     std::array<FilterPair,NUM_LINES> mFilter;
@@ -1368,6 +1417,41 @@ inline auto VectorPartialScatter(const std::array<float,NUM_LINES> &in, const fl
     };
 }
 
+#if HAVE_SSE_INTRINSICS
+
+/* The same as above, with the four lines in a vector. */
+inline auto VectorPartialScatter(const __m128 in, const __m128 xCoeff, const __m128 yCoeff)
+    noexcept -> __m128
+{
+    const auto a = _mm_mul_ps(_mm_shuffle_ps(in, in, _MM_SHUFFLE(0, 0, 0, 1)),
+        _mm_setr_ps(1.0f, -1.0f, 1.0f, -1.0f));
+    const auto b = _mm_mul_ps(_mm_shuffle_ps(in, in, _MM_SHUFFLE(1, 1, 2, 2)),
+        _mm_setr_ps(-1.0f, 1.0f, -1.0f, -1.0f));
+    const auto c = _mm_mul_ps(_mm_shuffle_ps(in, in, _MM_SHUFFLE(2, 3, 3, 3)),
+        _mm_setr_ps(1.0f, 1.0f, 1.0f, -1.0f));
+    return _mm_add_ps(_mm_mul_ps(xCoeff, in), _mm_mul_ps(yCoeff, _mm_add_ps(_mm_add_ps(a, b), c)));
+}
+
+#elif HAVE_NEON
+
+inline auto VectorPartialScatter(const float32x4_t in, const float32x4_t xCoeff,
+    const float32x4_t yCoeff) noexcept -> float32x4_t
+{
+    static constexpr auto signs_a = std::array{1.0f, -1.0f, 1.0f, -1.0f};
+    static constexpr auto signs_b = std::array{-1.0f, 1.0f, -1.0f, -1.0f};
+    static constexpr auto signs_c = std::array{1.0f, 1.0f, 1.0f, -1.0f};
+    const auto lo = vget_low_f32(in);
+    const auto hi = vget_high_f32(in);
+    const auto a = vmulq_f32(vcombine_f32(vrev64_f32(lo), vdup_lane_f32(lo, 0)),
+        vld1q_f32(signs_a.data()));
+    const auto b = vmulq_f32(vcombine_f32(vdup_lane_f32(hi, 0), vdup_lane_f32(lo, 1)),
+        vld1q_f32(signs_b.data()));
+    const auto c = vmulq_f32(vcombine_f32(vdup_lane_f32(hi, 1), vrev64_f32(hi)),
+        vld1q_f32(signs_c.data()));
+    return vaddq_f32(vmulq_f32(xCoeff, in), vmulq_f32(yCoeff, vaddq_f32(vaddq_f32(a, b), c)));
+}
+#endif
+
 /* Utilizes the above, but also applies a line-based reflection on the input
  * channels (swapping 0<->3 and 1<->2).
  */
@@ -1376,7 +1460,48 @@ void VectorScatterRev(const float xCoeff, const float yCoeff,
 {
     ASSUME(count > 0);
 
-    for(size_t i{0u};i < count;++i)
+    /* With SIMD, process four samples at a time with each line in its own
+     * vector.
+     */
+    size_t i{0u};
+#if HAVE_SSE_INTRINSICS
+    const auto x4 = _mm_set1_ps(xCoeff);
+    const auto y4 = _mm_set1_ps(yCoeff);
+    for(;count-i >= 4;i+=4)
+    {
+        const auto in0 = _mm_load_ps(&samples[3][i]);
+        const auto in1 = _mm_load_ps(&samples[2][i]);
+        const auto in2 = _mm_load_ps(&samples[1][i]);
+        const auto in3 = _mm_load_ps(&samples[0][i]);
+        _mm_store_ps(&samples[0][i], _mm_add_ps(_mm_mul_ps(x4, in0),
+            _mm_mul_ps(y4, _mm_add_ps(_mm_sub_ps(in1, in2), in3))));
+        _mm_store_ps(&samples[1][i], _mm_add_ps(_mm_mul_ps(x4, in1),
+            _mm_mul_ps(y4, _mm_add_ps(_mm_sub_ps(in2, in0), in3))));
+        _mm_store_ps(&samples[2][i], _mm_add_ps(_mm_mul_ps(x4, in2),
+            _mm_mul_ps(y4, _mm_add_ps(_mm_sub_ps(in0, in1), in3))));
+        _mm_store_ps(&samples[3][i], _mm_sub_ps(_mm_mul_ps(x4, in3),
+            _mm_mul_ps(y4, _mm_add_ps(_mm_add_ps(in0, in1), in2))));
+    }
+#elif HAVE_NEON
+    const auto x4 = vdupq_n_f32(xCoeff);
+    const auto y4 = vdupq_n_f32(yCoeff);
+    for(;count-i >= 4;i+=4)
+    {
+        const auto in0 = vld1q_f32(&samples[3][i]);
+        const auto in1 = vld1q_f32(&samples[2][i]);
+        const auto in2 = vld1q_f32(&samples[1][i]);
+        const auto in3 = vld1q_f32(&samples[0][i]);
+        vst1q_f32(&samples[0][i], vaddq_f32(vmulq_f32(x4, in0),
+            vmulq_f32(y4, vaddq_f32(vsubq_f32(in1, in2), in3))));
+        vst1q_f32(&samples[1][i], vaddq_f32(vmulq_f32(x4, in1),
+            vmulq_f32(y4, vaddq_f32(vsubq_f32(in2, in0), in3))));
+        vst1q_f32(&samples[2][i], vaddq_f32(vmulq_f32(x4, in2),
+            vmulq_f32(y4, vaddq_f32(vsubq_f32(in0, in1), in3))));
+        vst1q_f32(&samples[3][i], vsubq_f32(vmulq_f32(x4, in3),
+            vmulq_f32(y4, vaddq_f32(vaddq_f32(in0, in1), in2))));
+    }
+#endif
+    for(;i < count;++i)
     {
         std::array src{samples[0][i], samples[1][i], samples[2][i], samples[3][i]};
 
@@ -1400,6 +1525,15 @@ void VecAllpass::process(const std::span<ReverbUpdateLine,NUM_LINES> samples, si
 {
     const auto linelen = size_t{Delay.mLine.size()/NUM_LINES};
     const float feedCoeff{Coeff};
+#if HAVE_SSE_INTRINSICS
+    const auto feedCoeff4 = _mm_set1_ps(feedCoeff);
+    const auto xCoeff4 = _mm_set1_ps(xCoeff);
+    const auto yCoeff4 = _mm_set1_ps(yCoeff);
+#elif HAVE_NEON
+    const auto feedCoeff4 = vdupq_n_f32(feedCoeff);
+    const auto xCoeff4 = vdupq_n_f32(xCoeff);
+    const auto yCoeff4 = vdupq_n_f32(yCoeff);
+#endif
 
     ASSUME(todo > 0);
 
@@ -1419,6 +1553,50 @@ void VecAllpass::process(const std::span<ReverbUpdateLine,NUM_LINES> samples, si
         auto delayOut = Delay.mLine.begin() + ptrdiff_t(main_offset*NUM_LINES);
         main_offset += td;
 
+#if HAVE_SSE_INTRINSICS
+        do {
+            const auto input = _mm_setr_ps(samples[0][i], samples[1][i], samples[2][i],
+                samples[3][i]);
+            const auto delayed = _mm_setr_ps(delayIn[ptrdiff_t(vap_offset[0]*NUM_LINES + 0)],
+                delayIn[ptrdiff_t(vap_offset[1]*NUM_LINES + 1)],
+                delayIn[ptrdiff_t(vap_offset[2]*NUM_LINES + 2)],
+                delayIn[ptrdiff_t(vap_offset[3]*NUM_LINES + 3)]);
+            const auto out = _mm_sub_ps(delayed, _mm_mul_ps(feedCoeff4, input));
+            const auto f = _mm_add_ps(input, _mm_mul_ps(feedCoeff4, out));
+
+            alignas(16) std::array<float,NUM_LINES> outvals{};
+            _mm_store_ps(outvals.data(), out);
+            for(size_t j{0u};j < NUM_LINES;j++)
+                samples[j][i] = outvals[j];
+            delayIn += NUM_LINES;
+            ++i;
+
+            _mm_storeu_ps(std::to_address(delayOut), VectorPartialScatter(f, xCoeff4, yCoeff4));
+            delayOut += NUM_LINES;
+        } while(--td);
+#elif HAVE_NEON
+        do {
+            const auto invals = std::array{samples[0][i], samples[1][i], samples[2][i],
+                samples[3][i]};
+            const auto delayvals = std::array{delayIn[ptrdiff_t(vap_offset[0]*NUM_LINES + 0)],
+                delayIn[ptrdiff_t(vap_offset[1]*NUM_LINES + 1)],
+                delayIn[ptrdiff_t(vap_offset[2]*NUM_LINES + 2)],
+                delayIn[ptrdiff_t(vap_offset[3]*NUM_LINES + 3)]};
+            const auto input = vld1q_f32(invals.data());
+            const auto out = vsubq_f32(vld1q_f32(delayvals.data()), vmulq_f32(feedCoeff4, input));
+            const auto f = vaddq_f32(input, vmulq_f32(feedCoeff4, out));
+
+            auto outvals = std::array<float,NUM_LINES>{};
+            vst1q_f32(outvals.data(), out);
+            for(size_t j{0u};j < NUM_LINES;j++)
+                samples[j][i] = outvals[j];
+            delayIn += NUM_LINES;
+            ++i;
+
+            vst1q_f32(std::to_address(delayOut), VectorPartialScatter(f, xCoeff4, yCoeff4));
+            delayOut += NUM_LINES;
+        } while(--td);
+#else
         do {
             std::array<float,NUM_LINES> f{};
             for(size_t j{0u};j < NUM_LINES;j++)
@@ -1435,6 +1613,7 @@ void VecAllpass::process(const std::span<ReverbUpdateLine,NUM_LINES> samples, si
             f = VectorPartialScatter(f, xCoeff, yCoeff);
             delayOut = std::copy_n(f.cbegin(), f.size(), delayOut);
         } while(--td);
+#endif
     }
 }
 
@@ -1476,6 +1655,127 @@ void Allpass4::process(const std::span<ReverbUpdateLine,NUM_LINES> samples, cons
 }
 
 
+/* Applies a pair of biquad filters to each of the four lines. With SIMD, the
+ * lines are processed together, each in their own vector lane, so the filters'
+ * serial dependency is paid once for all four lines.
+ */
+void ProcessLineFilters(const std::array<DualBiquad,NUM_LINES> &filters,
+    const std::span<ReverbUpdateLine,NUM_LINES> samples, const size_t todo) noexcept
+{
+    ASSUME(todo > 0);
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Transpose the coefficients and state so each line is in its own lane. */
+    alignas(16) std::array<std::array<float,NUM_LINES>,5> coeffs0{};
+    alignas(16) std::array<std::array<float,NUM_LINES>,5> coeffs1{};
+    alignas(16) std::array<std::array<float,NUM_LINES>,2> state0{};
+    alignas(16) std::array<std::array<float,NUM_LINES>,2> state1{};
+    for(size_t j{0u};j < NUM_LINES;++j)
+    {
+        const auto c0 = filters[j].f0.getCoeffs();
+        const auto c1 = filters[j].f1.getCoeffs();
+        for(size_t k{0u};k < c0.size();++k)
+        {
+            coeffs0[k][j] = c0[k];
+            coeffs1[k][j] = c1[k];
+        }
+        const auto z0 = filters[j].f0.getComponents();
+        const auto z1 = filters[j].f1.getComponents();
+        state0[0][j] = z0[0]; state0[1][j] = z0[1];
+        state1[0][j] = z1[0]; state1[1][j] = z1[1];
+    }
+
+    alignas(16) std::array<float,NUM_LINES> outvals{};
+#if HAVE_SSE_INTRINSICS
+    const auto b00 = _mm_load_ps(coeffs0[0].data());
+    const auto b01 = _mm_load_ps(coeffs0[1].data());
+    const auto b02 = _mm_load_ps(coeffs0[2].data());
+    const auto a01 = _mm_load_ps(coeffs0[3].data());
+    const auto a02 = _mm_load_ps(coeffs0[4].data());
+    const auto b10 = _mm_load_ps(coeffs1[0].data());
+    const auto b11 = _mm_load_ps(coeffs1[1].data());
+    const auto b12 = _mm_load_ps(coeffs1[2].data());
+    const auto a11 = _mm_load_ps(coeffs1[3].data());
+    const auto a12 = _mm_load_ps(coeffs1[4].data());
+    auto z01 = _mm_load_ps(state0[0].data());
+    auto z02 = _mm_load_ps(state0[1].data());
+    auto z11 = _mm_load_ps(state1[0].data());
+    auto z12 = _mm_load_ps(state1[1].data());
+    for(size_t i{0u};i < todo;++i)
+    {
+        const auto input = _mm_setr_ps(samples[0][i], samples[1][i], samples[2][i],
+            samples[3][i]);
+        const auto tmpout = _mm_add_ps(_mm_mul_ps(input, b00), z01);
+        z01 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(input, b01), _mm_mul_ps(tmpout, a01)), z02);
+        z02 = _mm_sub_ps(_mm_mul_ps(input, b02), _mm_mul_ps(tmpout, a02));
+
+        const auto output = _mm_add_ps(_mm_mul_ps(tmpout, b10), z11);
+        z11 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(tmpout, b11), _mm_mul_ps(output, a11)), z12);
+        z12 = _mm_sub_ps(_mm_mul_ps(tmpout, b12), _mm_mul_ps(output, a12));
+
+        _mm_store_ps(outvals.data(), output);
+        for(size_t j{0u};j < NUM_LINES;++j)
+            samples[j][i] = outvals[j];
+    }
+    _mm_store_ps(state0[0].data(), z01);
+    _mm_store_ps(state0[1].data(), z02);
+    _mm_store_ps(state1[0].data(), z11);
+    _mm_store_ps(state1[1].data(), z12);
+#else
+    const auto b00 = vld1q_f32(coeffs0[0].data());
+    const auto b01 = vld1q_f32(coeffs0[1].data());
+    const auto b02 = vld1q_f32(coeffs0[2].data());
+    const auto a01 = vld1q_f32(coeffs0[3].data());
+    const auto a02 = vld1q_f32(coeffs0[4].data());
+    const auto b10 = vld1q_f32(coeffs1[0].data());
+    const auto b11 = vld1q_f32(coeffs1[1].data());
+    const auto b12 = vld1q_f32(coeffs1[2].data());
+    const auto a11 = vld1q_f32(coeffs1[3].data());
+    const auto a12 = vld1q_f32(coeffs1[4].data());
+    auto z01 = vld1q_f32(state0[0].data());
+    auto z02 = vld1q_f32(state0[1].data());
+    auto z11 = vld1q_f32(state1[0].data());
+    auto z12 = vld1q_f32(state1[1].data());
+    for(size_t i{0u};i < todo;++i)
+    {
+        const auto invals = std::array{samples[0][i], samples[1][i], samples[2][i],
+            samples[3][i]};
+        const auto input = vld1q_f32(invals.data());
+        const auto tmpout = vaddq_f32(vmulq_f32(input, b00), z01);
+        z01 = vaddq_f32(vsubq_f32(vmulq_f32(input, b01), vmulq_f32(tmpout, a01)), z02);
+        z02 = vsubq_f32(vmulq_f32(input, b02), vmulq_f32(tmpout, a02));
+
+        const auto output = vaddq_f32(vmulq_f32(tmpout, b10), z11);
+        z11 = vaddq_f32(vsubq_f32(vmulq_f32(tmpout, b11), vmulq_f32(output, a11)), z12);
+        z12 = vsubq_f32(vmulq_f32(tmpout, b12), vmulq_f32(output, a12));
+
+        vst1q_f32(outvals.data(), output);
+        for(size_t j{0u};j < NUM_LINES;++j)
+            samples[j][i] = outvals[j];
+    }
+    vst1q_f32(state0[0].data(), z01);
+    vst1q_f32(state0[1].data(), z02);
+    vst1q_f32(state1[0].data(), z11);
+    vst1q_f32(state1[1].data(), z12);
+#endif
+
+    for(size_t j{0u};j < NUM_LINES;++j)
+    {
+        filters[j].f0.setComponents(state0[0][j], state0[1][j]);
+        filters[j].f1.setComponents(state1[0][j], state1[1][j]);
+    }
+
+#else
+
+    for(size_t j{0u};j < NUM_LINES;++j)
+    {
+        auto filter = filters[j];
+        filter.process(std::span{samples[j]}.first(todo), samples[j]);
+    }
+#endif
+}
+
+
 /* This generates early reflections.
  *
  * This is done by obtaining the primary reflections (those arriving from the
@@ -1543,12 +1843,12 @@ void ReverbPipeline::processEarly(const DelayLineU &main_delay, size_t offset,
                 early_delay_tap1 += td;
                 i += td;
             }
-
-            /* Band-pass the incoming samples. */
-            auto&& filter = DualBiquad{mFilter[j].Lp, mFilter[j].Hp};
-            filter.process(std::span{tempSamples[j]}.first(todo), tempSamples[j]);
         }
 
+        /* Band-pass the incoming samples. */
+        ProcessLineFilters({mFilter[0].getFilter(), mFilter[1].getFilter(),
+            mFilter[2].getFilter(), mFilter[3].getFilter()}, tempSamples, todo);
+
         /* Apply an all-pass, to help color the initial reflections. */
         mEarly.VecAp.process(tempSamples, offset, todo);
 
@@ -1651,9 +1951,95 @@ void ReverbPipeline::processLate(size_t offset, const size_t samplesToDo,
         /* First, calculate the modulated delays for the late feedback. */
         const auto delays = mLate.Mod.calcDelays(todo);
 
-        /* Now load samples from the feedback delay lines. Filter the signal to
-         * apply its frequency-dependent decay.
+        /* Now load samples from the feedback delay lines. */
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+        /* The modulated delay is the same for each line, so the lines can be
+         * interpolated together with shared coefficients. Each line's four
+         * samples are loaded into a vector, then transposed so each vector
+         * holds the same sample position for all four lines.
          */
+        {
+            const auto inputs = std::array{late_delay.get(0), late_delay.get(1),
+                late_delay.get(2), late_delay.get(3)};
+            const auto mask = size_t{inputs[0].size()-1};
+            auto late_feedb_taps = std::array<size_t,NUM_LINES>{};
+            alignas(16) auto midgains = std::array<float,NUM_LINES>{};
+            for(size_t j{0_uz};j < NUM_LINES;++j)
+            {
+                late_feedb_taps[j] = offset - mLate.Offset[j];
+                midgains[j] = mLate.T60[j].MidGain;
+            }
+            alignas(16) auto outvals = std::array<float,NUM_LINES>{};
+
+#if HAVE_SSE_INTRINSICS
+            const auto midGain = _mm_load_ps(midgains.data());
+            auto load_taps = [&inputs,mask](const size_t j, const size_t delay) -> __m128
+            {
+                const auto input = inputs[j];
+                const auto pos3 = size_t{(delay-3) & mask};
+                if(pos3 < mask-2) [[likely]]
+                    return _mm_loadu_ps(&input[pos3]);
+                return _mm_setr_ps(input[pos3], input[(delay-2) & mask], input[(delay-1) & mask],
+                    input[delay & mask]);
+            };
+#else
+            const auto midGain = vld1q_f32(midgains.data());
+            auto load_taps = [&inputs,mask](const size_t j, const size_t delay) -> float32x4_t
+            {
+                const auto input = inputs[j];
+                const auto pos3 = size_t{(delay-3) & mask};
+                if(pos3 < mask-2) [[likely]]
+                    return vld1q_f32(&input[pos3]);
+                const auto vals = std::array{input[pos3], input[(delay-2) & mask],
+                    input[(delay-1) & mask], input[delay & mask]};
+                return vld1q_f32(vals.data());
+            };
+#endif
+            for(size_t i{0_uz};i < todo;++i)
+            {
+                const auto idelay = size_t{delays[i]};
+                const auto delayoffset = size_t{idelay & gCubicTable.sTableMask};
+                const auto delaybase = size_t{i - (idelay>>gCubicTable.sTableBits)};
+
+#if HAVE_SSE_INTRINSICS
+                auto tap3 = load_taps(0, late_feedb_taps[0] + delaybase);
+                auto tap2 = load_taps(1, late_feedb_taps[1] + delaybase);
+                auto tap1 = load_taps(2, late_feedb_taps[2] + delaybase);
+                auto tap0 = load_taps(3, late_feedb_taps[3] + delaybase);
+                _MM_TRANSPOSE4_PS(tap3, tap2, tap1, tap0);
+
+                const auto out = _mm_add_ps(_mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(tap0, _mm_set1_ps(gCubicTable.getCoeff0(delayoffset))),
+                    _mm_mul_ps(tap1, _mm_set1_ps(gCubicTable.getCoeff1(delayoffset)))),
+                    _mm_mul_ps(tap2, _mm_set1_ps(gCubicTable.getCoeff2(delayoffset)))),
+                    _mm_mul_ps(tap3, _mm_set1_ps(gCubicTable.getCoeff3(delayoffset))));
+                _mm_store_ps(outvals.data(), _mm_mul_ps(out, midGain));
+#else
+                const auto taps01 = vtrnq_f32(load_taps(0, late_feedb_taps[0] + delaybase),
+                    load_taps(1, late_feedb_taps[1] + delaybase));
+                const auto taps23 = vtrnq_f32(load_taps(2, late_feedb_taps[2] + delaybase),
+                    load_taps(3, late_feedb_taps[3] + delaybase));
+                const auto tap3 = vcombine_f32(vget_low_f32(taps01.val[0]),
+                    vget_low_f32(taps23.val[0]));
+                const auto tap2 = vcombine_f32(vget_low_f32(taps01.val[1]),
+                    vget_low_f32(taps23.val[1]));
+                const auto tap1 = vcombine_f32(vget_high_f32(taps01.val[0]),
+                    vget_high_f32(taps23.val[0]));
+                const auto tap0 = vcombine_f32(vget_high_f32(taps01.val[1]),
+                    vget_high_f32(taps23.val[1]));
+
+                const auto out = vaddq_f32(vaddq_f32(vaddq_f32(
+                    vmulq_f32(tap0, vdupq_n_f32(gCubicTable.getCoeff0(delayoffset))),
+                    vmulq_f32(tap1, vdupq_n_f32(gCubicTable.getCoeff1(delayoffset)))),
+                    vmulq_f32(tap2, vdupq_n_f32(gCubicTable.getCoeff2(delayoffset)))),
+                    vmulq_f32(tap3, vdupq_n_f32(gCubicTable.getCoeff3(delayoffset))));
+                vst1q_f32(outvals.data(), vmulq_f32(out, midGain));
+#endif
+                for(size_t j{0_uz};j < NUM_LINES;++j)
+                    tempSamples[j][i] = outvals[j];
+            }
+        }
+#else
         for(size_t j{0_uz};j < NUM_LINES;++j)
         {
             const auto input = late_delay.get(j);
@@ -1684,9 +2070,12 @@ void ReverbPipeline::processLate(size_t offset, const size_t samplesToDo,
                     + out3*gCubicTable.getCoeff3(delayoffset);
                 return out * midGain;
             });
-
-            mLate.T60[j].process(std::span{tempSamples[j]}.first(todo));
         }
+#endif
+
+        /* Apply the T60 damping filters. */
+        ProcessLineFilters({mLate.T60[0].getFilter(), mLate.T60[1].getFilter(),
+            mLate.T60[2].getFilter(), mLate.T60[3].getFilter()}, tempSamples, todo);
 
         /* Next load decorrelated samples from the main delay lines. */
         const float fadeStep{1.0f / static_cast<float>(todo)};
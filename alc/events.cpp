@@ -42,6 +42,10 @@ std::optional<alc::EventType> GetEventType(ALCenum type)
 
 void Event(EventType eventType, DeviceType deviceType, ALCdevice *device, std::string_view message) noexcept
 {
+    auto &eventcount = (deviceType == DeviceType::Playback) ? PlaybackEventCount
+        : CaptureEventCount;
+    eventcount.fetch_add(1u, std::memory_order_release);
+
     auto eventlock = std::unique_lock{EventMutex};
     if(EventCallback && EventsEnabled.test(al::to_underlying(eventType)))
         EventCallback(EnumFromEventType(eventType), al::to_underlying(deviceType), device,
@@ -4,6 +4,7 @@
 #include "inprogext.h"
 #include "opthelpers.h"
 
+#include <atomic>
 #include <bitset>
 #include <mutex>
 #include <optional>
@@ -40,6 +41,12 @@ inline std::mutex EventMutex;
 inline ALCEVENTPROCTYPESOFT EventCallback{};
 inline void *EventUserPtr{};
 
+/* Counts the events sent for each device type, whether or not the app is
+ * listening for them, so cached device lists can tell when they're stale.
+ */
+inline std::atomic<unsigned int> PlaybackEventCount{0u};
+inline std::atomic<unsigned int> CaptureEventCount{0u};
+
 void Event(EventType eventType, DeviceType deviceType, ALCdevice *device, std::string_view message) noexcept;
 
 inline void Event(EventType eventType, DeviceType deviceType, std::string_view message) noexcept
@@ -63,6 +63,9 @@ inline const FuncExport alcFunctions[]{
     DECL(alcEventControlSOFT),
     DECL(alcEventCallbackSOFT),
 
+    DECL(alcCaptureAcquireSamplesSOFT),
+    DECL(alcCaptureReleaseSamplesSOFT),
+
     DECL(alEnable),
     DECL(alDisable),
     DECL(alIsEnabled),
@@ -207,6 +210,10 @@ inline const FuncExport alcFunctions[]{
     DECL(alSourcePlayAtTimeSOFT),
     DECL(alSourcePlayAtTimevSOFT),
 
+    DECL(alSourceRampfSOFT),
+
+    DECL(alGetSourceStatusvSOFT),
+
     DECL(alBufferSubDataSOFT),
 
     DECL(alBufferDataStatic),
@@ -361,6 +368,8 @@ inline const FuncExport alcFunctions[]{
     DECL(alGetSourcedvDirectSOFT),
     DECL(alSourcePlayAtTimeDirectSOFT),
     DECL(alSourcePlayAtTimevDirectSOFT),
+    DECL(alSourceRampfDirectSOFT),
+    DECL(alGetSourceStatusvDirectSOFT),
 
     DECL(alEventControlDirectSOFT),
     DECL(alEventCallbackDirectSOFT),
@@ -501,6 +510,9 @@ inline const EnumExport alcEnumerations[]{
     DECL(ALC_EVENT_TYPE_DEVICE_ADDED_SOFT),
     DECL(ALC_EVENT_TYPE_DEVICE_REMOVED_SOFT),
 
+    DECL(ALC_PREALLOC_VOICES_SOFT),
+    DECL(ALC_PREALLOC_EFFECT_SLOTS_SOFT),
+
 
     DECL(AL_INVALID),
     DECL(AL_NONE),
@@ -639,6 +651,23 @@ inline const EnumExport alcEnumerations[]{
     DECL(AL_FORMAT_UHJ3CHN_I32_SOFT),
     DECL(AL_FORMAT_UHJ4CHN_I32_SOFT),
 
+    DECL(AL_FORMAT_MONO_HALF_SOFT),
+    DECL(AL_FORMAT_STEREO_HALF_SOFT),
+    DECL(AL_FORMAT_QUAD_HALF_SOFT),
+    DECL(AL_FORMAT_51CHN_HALF_SOFT),
+    DECL(AL_FORMAT_61CHN_HALF_SOFT),
+    DECL(AL_FORMAT_71CHN_HALF_SOFT),
+    DECL(AL_FORMAT_BFORMAT2D_HALF_SOFT),
+    DECL(AL_FORMAT_BFORMAT3D_HALF_SOFT),
+    DECL(AL_FORMAT_MONO_I24_SOFT),
+    DECL(AL_FORMAT_STEREO_I24_SOFT),
+    DECL(AL_FORMAT_QUAD_I24_SOFT),
+    DECL(AL_FORMAT_51CHN_I24_SOFT),
+    DECL(AL_FORMAT_61CHN_I24_SOFT),
+    DECL(AL_FORMAT_71CHN_I24_SOFT),
+    DECL(AL_FORMAT_BFORMAT2D_I24_SOFT),
+    DECL(AL_FORMAT_BFORMAT3D_I24_SOFT),
+
     DECL(AL_FORMAT_REAR_FLOAT32),
     DECL(AL_FORMAT_QUAD_FLOAT32),
     DECL(AL_FORMAT_51CHN_FLOAT32),
@@ -909,12 +938,20 @@ inline const EnumExport alcEnumerations[]{
     DECL(AL_PANNING_ENABLED_SOFT),
     DECL(AL_PAN_SOFT),
 
+    DECL(AL_RAMP_GAIN_SOFT),
+
+    DECL(AL_POOL_ALLOCATIONS_SOFT),
+
+    DECL(AL_SOURCE_LOW_WATERMARK_SOFT),
+    DECL(AL_EVENT_TYPE_SOURCE_LOW_WATERMARK_SOFT),
+
     DECL(AL_STOP_SOURCES_ON_DISCONNECT_SOFT),
 };
 #if ALSOFT_EAX
 inline const std::array eaxEnumerations{
     DECL(AL_EAX_RAM_SIZE),
     DECL(AL_EAX_RAM_FREE),
+    DECL(AL_EAX_COMMITS_AVOIDED_SOFT),
     DECL(AL_STORAGE_AUTOMATIC),
     DECL(AL_STORAGE_HARDWARE),
     DECL(AL_STORAGE_ACCESSIBLE),
@@ -79,6 +79,80 @@ void AL_APIENTRY alFlushMappedBufferDirectSOFT(ALCcontext *context, ALuint buffe
 #define AL_PAN_SOFT                              0x19ED
 #endif
 
+#ifndef AL_SOFT_source_ramp
+#define AL_SOFT_source_ramp
+#define AL_RAMP_GAIN_SOFT                        0x19EE
+typedef void (AL_APIENTRY*LPALSOURCERAMPFSOFT)(ALuint source, ALenum param, ALfloat value, ALint64SOFT start_time, ALint64SOFT duration) AL_API_NOEXCEPT17;
+typedef void (AL_APIENTRY*LPALSOURCERAMPFDIRECTSOFT)(ALCcontext *context, ALuint source, ALenum param, ALfloat value, ALint64SOFT start_time, ALint64SOFT duration) AL_API_NOEXCEPT17;
+#ifdef AL_ALEXT_PROTOTYPES
+void AL_APIENTRY alSourceRampfSOFT(ALuint source, ALenum param, ALfloat value, ALint64SOFT start_time, ALint64SOFT duration) AL_API_NOEXCEPT;
+void AL_APIENTRY alSourceRampfDirectSOFT(ALCcontext *context, ALuint source, ALenum param, ALfloat value, ALint64SOFT start_time, ALint64SOFT duration) AL_API_NOEXCEPT;
+#endif
+#endif
+
+#ifndef AL_SOFT_source_low_watermark
+#define AL_SOFT_source_low_watermark
+#define AL_SOURCE_LOW_WATERMARK_SOFT             0x19F2
+#define AL_EVENT_TYPE_SOURCE_LOW_WATERMARK_SOFT  0x19F3
+#endif
+
+#ifndef AL_SOFT_half_i24_formats
+#define AL_SOFT_half_i24_formats
+#define AL_FORMAT_MONO_HALF_SOFT                 0x19F4
+#define AL_FORMAT_STEREO_HALF_SOFT               0x19F5
+#define AL_FORMAT_QUAD_HALF_SOFT                 0x19F6
+#define AL_FORMAT_51CHN_HALF_SOFT                0x19F7
+#define AL_FORMAT_61CHN_HALF_SOFT                0x19F8
+#define AL_FORMAT_71CHN_HALF_SOFT                0x19F9
+#define AL_FORMAT_BFORMAT2D_HALF_SOFT            0x19FA
+#define AL_FORMAT_BFORMAT3D_HALF_SOFT            0x19FB
+
+#define AL_FORMAT_MONO_I24_SOFT                  0x19FC
+#define AL_FORMAT_STEREO_I24_SOFT                0x19FD
+#define AL_FORMAT_QUAD_I24_SOFT                  0x19FE
+#define AL_FORMAT_51CHN_I24_SOFT                 0x19FF
+#define AL_FORMAT_61CHN_I24_SOFT                 0x1A00
+#define AL_FORMAT_71CHN_I24_SOFT                 0x1A01
+#define AL_FORMAT_BFORMAT2D_I24_SOFT             0x1A02
+#define AL_FORMAT_BFORMAT3D_I24_SOFT             0x1A03
+#endif
+
+#ifndef AL_SOFT_source_status_batch
+#define AL_SOFT_source_status_batch
+typedef void (AL_APIENTRY*LPALGETSOURCESTATUSVSOFT)(ALsizei n, const ALuint *sources, ALint *states, ALint64SOFT *offsets, ALint *processed, ALint64SOFT *clocktime) AL_API_NOEXCEPT17;
+typedef void (AL_APIENTRY*LPALGETSOURCESTATUSVDIRECTSOFT)(ALCcontext *context, ALsizei n, const ALuint *sources, ALint *states, ALint64SOFT *offsets, ALint *processed, ALint64SOFT *clocktime) AL_API_NOEXCEPT17;
+#ifdef AL_ALEXT_PROTOTYPES
+void AL_APIENTRY alGetSourceStatusvSOFT(ALsizei n, const ALuint *sources, ALint *states, ALint64SOFT *offsets, ALint *processed, ALint64SOFT *clocktime) AL_API_NOEXCEPT;
+void AL_APIENTRY alGetSourceStatusvDirectSOFT(ALCcontext *context, ALsizei n, const ALuint *sources, ALint *states, ALint64SOFT *offsets, ALint *processed, ALint64SOFT *clocktime) AL_API_NOEXCEPT;
+#endif
+#endif
+
+#ifndef ALC_SOFT_capture_view
+#define ALC_SOFT_capture_view
+typedef void (ALC_APIENTRY*LPALCCAPTUREACQUIRESAMPLESSOFT)(ALCdevice *device, const ALCvoid **data1, ALCsizei *samples1, const ALCvoid **data2, ALCsizei *samples2) ALC_API_NOEXCEPT17;
+typedef void (ALC_APIENTRY*LPALCCAPTURERELEASESAMPLESSOFT)(ALCdevice *device, ALCsizei samples) ALC_API_NOEXCEPT17;
+#ifdef AL_ALEXT_PROTOTYPES
+void ALC_APIENTRY alcCaptureAcquireSamplesSOFT(ALCdevice *device, const ALCvoid **data1, ALCsizei *samples1, const ALCvoid **data2, ALCsizei *samples2) ALC_API_NOEXCEPT;
+void ALC_APIENTRY alcCaptureReleaseSamplesSOFT(ALCdevice *device, ALCsizei samples) ALC_API_NOEXCEPT;
+#endif
+#endif
+
+#ifndef ALC_SOFT_context_preallocation
+#define ALC_SOFT_context_preallocation
+#define ALC_PREALLOC_VOICES_SOFT                 0x19EF
+#define ALC_PREALLOC_EFFECT_SLOTS_SOFT           0x19F0
+#endif
+
+#ifndef AL_SOFT_context_preallocation
+#define AL_SOFT_context_preallocation
+#define AL_POOL_ALLOCATIONS_SOFT                 0x19F1
+#endif
+
+#ifndef AL_SOFT_eax_commit_stats
+#define AL_SOFT_eax_commit_stats
+#define AL_EAX_COMMITS_AVOIDED_SOFT              0x1A04
+#endif
+
 /* Non-standard exports. Not part of any extension. */
 AL_API const ALchar* AL_APIENTRY alsoft_get_version(void) noexcept;
 
@@ -1094,6 +1094,7 @@ void aluInitRenderer(al::Device *device, int hrtf_id, std::optional<StereoEncodi
     HrtfStorePtr old_hrtf{std::move(device->mHrtf)};
 
     device->mHrtfState = nullptr;
+    device->mHrtfCache = nullptr;
     device->mHrtf = nullptr;
     device->mIrSize = 0;
     device->mHrtfName.clear();
@@ -1219,6 +1220,7 @@ void aluInitRenderer(al::Device *device, int hrtf_id, std::optional<StereoEncodi
             }
 
             InitHrtfPanning(device);
+            device->mHrtfCache = std::make_unique<HrtfCoeffCache>();
             device->PostProcess = &al::Device::ProcessHrtf;
             device->mHrtfStatus = ALC_HRTF_ENABLED_SOFT;
             return;
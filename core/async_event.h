@@ -16,6 +16,7 @@ enum class AsyncEnableBits : std::uint8_t {
     SourceState,
     BufferCompleted,
     Disconnected,
+    LowWatermark,
     Count
 };
 
@@ -39,6 +40,11 @@ struct AsyncBufferCompleteEvent {
     uint mCount;
 };
 
+struct AsyncSourceLowWatermarkEvent {
+    uint mId;
+    uint mRemaining;
+};
+
 struct AsyncDisconnectEvent {
     std::string msg;
 };
@@ -50,6 +56,7 @@ struct AsyncEffectReleaseEvent {
 using AsyncEvent = std::variant<AsyncKillThread,
         AsyncSourceStateEvent,
         AsyncBufferCompleteEvent,
+        AsyncSourceLowWatermarkEvent,
         AsyncEffectReleaseEvent,
         AsyncDisconnectEvent>;
 
@@ -15,6 +15,7 @@
 #include "flexarray.h"
 #include "front_stablizer.h"
 #include "mixer.h"
+#include "mixer/defs.h"
 #include "opthelpers.h"
 
 
@@ -35,26 +36,31 @@ BFormatDec::BFormatDec(const size_t inchans, const std::span<const ChannelDec> c
 {
     if(coeffslf.empty())
     {
-        auto &decoder = mChannelDec.emplace<SBandDecoderVector>(inchans);
-        for(size_t j{0};j < decoder.size();++j)
+        auto &decoder = mChannelDec.emplace<SBandDecoder>();
+        decoder.mGains.resize(inchans);
+        for(size_t j{0};j < inchans;++j)
         {
-            std::transform(coeffs.begin(), coeffs.end(), decoder[j].mGains.begin(),
+            std::transform(coeffs.begin(), coeffs.end(), decoder.mGains[j].begin(),
                 [j](const ChannelDec &incoeffs) { return incoeffs[j]; });
         }
     }
     else
     {
-        auto &decoder = mChannelDec.emplace<DBandDecoderVector>(inchans);
-        decoder[0].mXOver.init(xover_f0norm);
-        for(size_t j{1};j < decoder.size();++j)
-            decoder[j].mXOver = decoder[0].mXOver;
-
-        for(size_t j{0};j < decoder.size();++j)
+        auto &decoder = mChannelDec.emplace<DBandDecoder>();
+        decoder.mXOver.resize(inchans);
+        decoder.mXOver[0].init(xover_f0norm);
+        std::fill(decoder.mXOver.begin()+1, decoder.mXOver.end(), decoder.mXOver[0]);
+
+        decoder.mGains.resize(inchans*sNumBands);
+        decoder.mSamples.resize(inchans*sNumBands);
+        for(size_t j{0};j < inchans;++j)
         {
-            std::transform(coeffs.begin(), coeffs.end(), decoder[j].mGains[sHFBand].begin(),
+            std::transform(coeffs.begin(), coeffs.end(),
+                decoder.mGains[j*sNumBands + sHFBand].begin(),
                 [j](const ChannelDec &incoeffs) { return incoeffs[j]; });
 
-            std::transform(coeffslf.begin(), coeffslf.end(), decoder[j].mGains[sLFBand].begin(),
+            std::transform(coeffslf.begin(), coeffslf.end(),
+                decoder.mGains[j*sNumBands + sLFBand].begin(),
                 [j](const ChannelDec &incoeffs) { return incoeffs[j]; });
         }
     }
@@ -67,30 +73,35 @@ void BFormatDec::process(const std::span<FloatBufferLine> OutBuffer,
     ASSUME(SamplesToDo > 0);
 
     std::visit(overloaded {
-        [=,this](DBandDecoderVector &decoder)
+        [=](DBandDecoder &decoder)
         {
-            auto input = InSamples.begin();
-            const auto hfSamples = std::span<float>{mSamples[sHFBand]}.first(SamplesToDo);
-            const auto lfSamples = std::span<float>{mSamples[sLFBand]}.first(SamplesToDo);
-            for(auto &chandec : decoder)
+            /* Split and decode the input in tiles, so the band-split samples
+             * are still in cache when they get mixed.
+             */
+            for(size_t base{0};base < SamplesToDo;base += MixerMatrixTileSize)
             {
-                chandec.mXOver.process(std::span{*input}.first(SamplesToDo), hfSamples, lfSamples);
-                MixSamples(hfSamples, OutBuffer, chandec.mGains[sHFBand], chandec.mGains[sHFBand],
-                    0, 0);
-                MixSamples(lfSamples, OutBuffer, chandec.mGains[sLFBand], chandec.mGains[sLFBand],
-                    0, 0);
-                ++input;
+                const auto todo = std::min(MixerMatrixTileSize, SamplesToDo-base);
+                const auto numchans = decoder.mXOver.size();
+                auto splitters = std::array<BandSplitter*,MaxAmbiChannels>{};
+                auto input = std::array<const float*,MaxAmbiChannels>{};
+                auto hfout = std::array<float*,MaxAmbiChannels>{};
+                auto lfout = std::array<float*,MaxAmbiChannels>{};
+                for(size_t j{0};j < numchans;++j)
+                {
+                    splitters[j] = &decoder.mXOver[j];
+                    input[j] = &InSamples[j][base];
+                    hfout[j] = &decoder.mSamples[j*sNumBands + sHFBand][base];
+                    lfout[j] = &decoder.mSamples[j*sNumBands + sLFBand][base];
+                }
+                BandSplitter::processGroup(std::span{splitters}.first(numchans), input, hfout,
+                    lfout, todo);
+                MixMatrix(decoder.mSamples, OutBuffer, decoder.mGains, base, todo);
             }
         },
-        [=](SBandDecoderVector &decoder)
+        [=](SBandDecoder &decoder)
         {
-            auto input = InSamples.begin();
-            for(auto &chandec : decoder)
-            {
-                MixSamples(std::span{*input}.first(SamplesToDo), OutBuffer, chandec.mGains,
-                    chandec.mGains, 0, 0);
-                ++input;
-            }
+            MixMatrix(InSamples.first(decoder.mGains.size()), OutBuffer, decoder.mGains, 0,
+                SamplesToDo);
         },
     }, mChannelDec);
 }
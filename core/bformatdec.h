@@ -14,6 +14,7 @@
 #include "filters/splitter.h"
 #include "front_stablizer.h"
 #include "opthelpers.h"
+#include "vector.h"
 
 
 using ChannelDec = std::array<float,MaxAmbiChannels>;
@@ -23,22 +24,25 @@ class SIMDALIGN BFormatDec {
     static constexpr size_t sLFBand{1};
     static constexpr size_t sNumBands{2};
 
-    struct ChannelDecoderSingle {
-        std::array<float,MaxOutputChannels> mGains{};
-    };
-    using SBandDecoderVector = std::vector<ChannelDecoderSingle>;
+    using GainRow = std::array<float,MaxOutputChannels>;
 
-    struct ChannelDecoderDual {
-        BandSplitter mXOver;
-        std::array<std::array<float,MaxOutputChannels>,sNumBands> mGains{};
+    /* The gain matrix has one row of output gains per input channel. */
+    struct SBandDecoder {
+        std::vector<GainRow> mGains;
     };
-    using DBandDecoderVector = std::vector<ChannelDecoderDual>;
 
-    alignas(16) std::array<FloatBufferLine,2> mSamples{};
+    /* The gain matrix has a row for each band of each input channel, matching
+     * the split sample lines (HF and LF for input 0, then input 1, etc).
+     */
+    struct DBandDecoder {
+        std::vector<BandSplitter> mXOver;
+        std::vector<GainRow> mGains;
+        al::vector<FloatBufferLine,16> mSamples;
+    };
 
     const std::unique_ptr<FrontStablizer> mStablizer;
 
-    std::variant<SBandDecoderVector,DBandDecoderVector> mChannelDec;
+    std::variant<SBandDecoder,DBandDecoder> mChannelDec;
 
 public:
     BFormatDec(const size_t inchans, const std::span<const ChannelDec> coeffs,
@@ -1,14 +1,20 @@
 #ifndef CORE_BUFFERLINE_H
 #define CORE_BUFFERLINE_H
 
+#include "config.h"
+
 #include <array>
 #include <span>
 
 /* Size for temporary storage of buffer data, in floats. Larger values need
  * more memory and are harder on cache, while smaller values may need more
- * iterations for mixing.
+ * iterations for mixing. Set at build time with ALSOFT_BUFFER_LINE_SIZE; low
+ * latency setups with small update sizes may prefer a smaller size to keep the
+ * device and effect buffers resident in cache.
  */
-inline constexpr size_t BufferLineSize{1024};
+inline constexpr size_t BufferLineSize{ALSOFT_BUFFER_LINE_SIZE};
+static_assert(BufferLineSize >= 128 && (BufferLineSize&(BufferLineSize-1)) == 0,
+    "BufferLineSize must be a power of 2, 128 or larger");
 
 using FloatBufferLine = std::array<float,BufferLineSize>;
 using FloatBufferSpan = std::span<float,BufferLineSize>;
@@ -28,6 +28,16 @@ ContextBase::ContextBase(DeviceBase *device) : mDevice{device}
 
 ContextBase::~ContextBase()
 {
+    TRACE("Context pools: {} voices, {} voice changes, {} voice props, {} effect slots, {} effect"
+        " slot props, {} context props ({} allocations)",
+        mVoiceClusters.size()*std::tuple_size_v<VoiceCluster::element_type>,
+        mVoiceChangeClusters.size()*std::tuple_size_v<VoiceChangeCluster::element_type>,
+        mVoicePropClusters.size()*std::tuple_size_v<VoicePropsCluster::element_type>,
+        mEffectSlotClusters.size()*std::tuple_size_v<EffectSlotCluster::element_type>,
+        mEffectSlotPropClusters.size()*std::tuple_size_v<EffectSlotPropsCluster::element_type>,
+        mContextPropClusters.size()*std::tuple_size_v<ContextPropsCluster::element_type>,
+        mPoolAllocCount.load(std::memory_order_relaxed));
+
     mActiveAuxSlots.store(nullptr, std::memory_order_relaxed);
     mVoices.store(nullptr, std::memory_order_relaxed);
 
@@ -62,6 +72,7 @@ void ContextBase::allocVoiceChanges()
 
     mVoiceChangeClusters.emplace_back(std::move(clusterptr));
     mVoiceChangeTail = mVoiceChangeClusters.back()->data();
+    mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
 }
 
 void ContextBase::allocVoiceProps()
@@ -76,6 +87,7 @@ void ContextBase::allocVoiceProps()
     for(size_t i{1};i < clustersize;++i)
         cluster[i-1].next.store(std::addressof(cluster[i]), std::memory_order_relaxed);
     mVoicePropClusters.emplace_back(std::move(clusterptr));
+    mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
 
     VoicePropsItem *oldhead{mFreeVoiceProps.load(std::memory_order_acquire)};
     do {
@@ -84,6 +96,28 @@ void ContextBase::allocVoiceProps()
         std::memory_order_acq_rel, std::memory_order_acquire) == false);
 }
 
+void ContextBase::preallocVoices()
+{
+    static constexpr size_t voiceclustersize{std::tuple_size_v<VoiceCluster::element_type>};
+    static constexpr size_t changeclustersize{
+        std::tuple_size_v<VoiceChangeCluster::element_type>};
+    static constexpr size_t propsclustersize{std::tuple_size_v<VoicePropsCluster::element_type>};
+
+    const size_t count{mPreallocVoices};
+    const size_t numvoices{mVoiceClusters.size() * voiceclustersize};
+    if(numvoices < count)
+        allocVoices(count - numvoices);
+
+    /* Voice changes are consumed by the mixer, which only returns them once
+     * later changes get processed, so allow for a few changes per voice.
+     */
+    while(mVoiceChangeClusters.size()*changeclustersize < count*2)
+        allocVoiceChanges();
+    /* Similar to effect slots, allow for two property updates per voice. */
+    while(mVoicePropClusters.size()*propsclustersize < count*2)
+        allocVoiceProps();
+}
+
 void ContextBase::allocVoices(size_t addcount)
 {
     static constexpr size_t clustersize{std::tuple_size_v<VoiceCluster::element_type>};
@@ -105,6 +139,7 @@ void ContextBase::allocVoices(size_t addcount)
     while(addcount)
     {
         mVoiceClusters.emplace_back(std::make_unique<VoiceCluster::element_type>());
+        mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
         --addcount;
     }
 
@@ -131,6 +166,7 @@ void ContextBase::allocEffectSlotProps()
     for(size_t i{1};i < clustersize;++i)
         cluster[i-1].next.store(std::addressof(cluster[i]), std::memory_order_relaxed);
     auto *newcluster = mEffectSlotPropClusters.emplace_back(std::move(clusterptr)).get();
+    mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
 
     EffectSlotProps *oldhead{mFreeEffectSlotProps.load(std::memory_order_acquire)};
     do {
@@ -139,6 +175,29 @@ void ContextBase::allocEffectSlotProps()
         std::memory_order_acq_rel, std::memory_order_acquire) == false);
 }
 
+void ContextBase::preallocEffectSlots()
+{
+    static constexpr size_t clustersize{std::tuple_size_v<EffectSlotCluster::element_type>};
+    static constexpr size_t propsclustersize{
+        std::tuple_size_v<EffectSlotPropsCluster::element_type>};
+
+    const size_t count{mPreallocEffectSlots};
+    if(mEffectSlotClusters.size()*clustersize < count)
+    {
+        TRACE("Preallocating {} effect slots", count);
+        while(mEffectSlotClusters.size()*clustersize < count)
+        {
+            mEffectSlotClusters.emplace_back(std::make_unique<EffectSlotCluster::element_type>());
+            mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
+        }
+    }
+    /* Each effect slot can have one update pending, plus one more to be set
+     * while the mixer holds on to the other.
+     */
+    while(mEffectSlotPropClusters.size()*propsclustersize < count*2)
+        allocEffectSlotProps();
+}
+
 EffectSlot *ContextBase::getEffectSlot()
 {
     for(auto& clusterptr : mEffectSlotClusters)
@@ -156,6 +215,7 @@ EffectSlot *ContextBase::getEffectSlot()
     TRACE("Increasing allocated effect slots to {}", totalcount);
 
     mEffectSlotClusters.emplace_back(std::move(clusterptr));
+    mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
     return mEffectSlotClusters.back()->data();
 }
 
@@ -172,6 +232,7 @@ void ContextBase::allocContextProps()
     for(size_t i{1};i < clustersize;++i)
         cluster[i-1].next.store(std::addressof(cluster[i]), std::memory_order_relaxed);
     auto *newcluster = mContextPropClusters.emplace_back(std::move(clusterptr)).get();
+    mPoolAllocCount.fetch_add(1u, std::memory_order_relaxed);
 
     ContextProps *oldhead{mFreeContextProps.load(std::memory_order_acquire)};
     do {
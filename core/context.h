@@ -113,6 +113,23 @@ struct ContextBase {
     void allocEffectSlotProps();
     void allocContextProps();
 
+    /* Object counts to preallocate for, so apps can avoid allocations from
+     * pool growth after the context is created.
+     */
+    unsigned int mPreallocVoices{0u};
+    unsigned int mPreallocEffectSlots{0u};
+
+    /* The number of cluster allocations made for the object pools. The pools
+     * don't shrink while the context is in use, so their sizes are also the
+     * high-water marks of what was needed.
+     */
+    std::atomic<unsigned int> mPoolAllocCount{0u};
+
+    /** Grows the voice, voice change, and voice prop pools to the preallocated size. */
+    void preallocVoices();
+    /** Grows the effect slot and effect slot prop pools to the preallocated size. */
+    void preallocEffectSlots();
+
     ContextParams mParams;
 
     using VoiceArray = al::FlexArray<Voice*>;
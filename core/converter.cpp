@@ -1,25 +1,43 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "converter.h"
 
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
 #include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <span>
+#include <type_traits>
+#include <variant>
+
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
 
 #include "alnumeric.h"
+#include "bsinc_defs.h"
 #include "fpu_ctrl.h"
+#include "opthelpers.h"
 
 
 namespace {
 
 constexpr uint MaxPitch{10};
 
+constexpr uint BSincPhaseDiffBits{MixerFracBits - BSincPhaseBits};
+constexpr uint BSincPhaseDiffOne{1 << BSincPhaseDiffBits};
+constexpr uint BSincPhaseDiffMask{BSincPhaseDiffOne - 1u};
+
 static_assert((BufferLineSize-1)/MaxPitch > 0, "MaxPitch is too large for BufferLineSize!");
 static_assert((INT_MAX>>MixerFracBits)/MaxPitch > BufferLineSize,
     "MaxPitch and/or BufferLineSize are too large for MixerFracBits!");
@@ -44,19 +62,130 @@ template<> constexpr float LoadSample<DevFmtUInt>(DevFmtType_t<DevFmtUInt> val)
 { return LoadSample<DevFmtInt>(static_cast<int32_t>(val - 2147483648u)); }
 
 
+/* The scale to normalize integer samples of the given type. */
+template<DevFmtType T>
+constexpr float SampleScale{static_cast<float>(1u << (sizeof(DevFmtType_t<T>)*8 - 1))};
+
+#if HAVE_SSE_INTRINSICS
+
+/* Loads 4 consecutive samples as floats, giving the same results as
+ * LoadSample.
+ */
+template<DevFmtType T>
+auto LoadSample4(const DevFmtType_t<T> *src) noexcept -> __m128
+{
+    using SampleType = DevFmtType_t<T>;
+    if constexpr(T == DevFmtFloat)
+        return _mm_loadu_ps(src);
+    else
+    {
+        __m128i ival;
+        if constexpr(sizeof(SampleType) == 4)
+        {
+            ival = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi32(std::numeric_limits<int32_t>::min()));
+        }
+        else if constexpr(sizeof(SampleType) == 2)
+        {
+            ival = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi16(std::numeric_limits<int16_t>::min()));
+            ival = _mm_srai_epi32(_mm_unpacklo_epi16(ival, ival), 16);
+        }
+        else
+        {
+            auto bytes = int32_t{};
+            std::memcpy(&bytes, src, sizeof(bytes));
+            ival = _mm_cvtsi32_si128(bytes);
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi8(std::numeric_limits<int8_t>::min()));
+            ival = _mm_unpacklo_epi8(ival, ival);
+            ival = _mm_srai_epi32(_mm_unpacklo_epi16(ival, ival), 24);
+        }
+        return _mm_mul_ps(_mm_cvtepi32_ps(ival), _mm_set1_ps(1.0f/SampleScale<T>));
+    }
+}
+
+#elif HAVE_NEON
+
+template<DevFmtType T>
+auto LoadSample4(const DevFmtType_t<T> *src) noexcept -> float32x4_t
+{
+    using SampleType = DevFmtType_t<T>;
+    if constexpr(T == DevFmtFloat)
+        return vld1q_f32(src);
+    else
+    {
+        int32x4_t ival;
+        if constexpr(sizeof(SampleType) == 4)
+        {
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = vreinterpretq_s32_u32(veorq_u32(vld1q_u32(src), vdupq_n_u32(0x80000000u)));
+            else
+                ival = vld1q_s32(src);
+        }
+        else if constexpr(sizeof(SampleType) == 2)
+        {
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = vmovl_s16(vreinterpret_s16_u16(veor_u16(vld1_u16(src), vdup_n_u16(0x8000))));
+            else
+                ival = vmovl_s16(vld1_s16(src));
+        }
+        else
+        {
+            auto bytes = uint32_t{};
+            std::memcpy(&bytes, src, sizeof(bytes));
+            auto bval = vcreate_u8(bytes);
+            if constexpr(std::is_unsigned_v<SampleType>)
+                bval = veor_u8(bval, vdup_n_u8(0x80));
+            ival = vmovl_s16(vget_low_s16(vmovl_s8(vreinterpret_s8_u8(bval))));
+        }
+        return vmulq_n_f32(vcvtq_f32_s32(ival), 1.0f/SampleScale<T>);
+    }
+}
+#endif
+
 template<DevFmtType T>
 inline void LoadSampleArray(const std::span<float> dst, const void *src, const size_t channel,
     const size_t srcstep) noexcept
 {
     assert(channel < srcstep);
     const auto srcspan = std::span{static_cast<const DevFmtType_t<T>*>(src), dst.size()*srcstep};
-    auto ssrc = srcspan.begin() + ptrdiff_t(channel);
-    dst.front() = LoadSample<T>(*ssrc);
-    std::generate(dst.begin()+1, dst.end(), [&ssrc,srcstep]
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Mono and stereo input is converted 4 samples at a time, with stereo
+     * being deinterleaved from 8 loaded samples.
+     */
+    const auto todo = dst.size() & ~3_uz;
+    if(srcstep == 1)
     {
-        ssrc += ptrdiff_t(srcstep);
-        return LoadSample<T>(*ssrc);
-    });
+        for(;i < todo;i += 4)
+        {
+#if HAVE_SSE_INTRINSICS
+            _mm_storeu_ps(&dst[i], LoadSample4<T>(&srcspan[i]));
+#else
+            vst1q_f32(&dst[i], LoadSample4<T>(&srcspan[i]));
+#endif
+        }
+    }
+    else if(srcstep == 2)
+    {
+        for(;i < todo;i += 4)
+        {
+            const auto s0 = LoadSample4<T>(&srcspan[i*2]);
+            const auto s1 = LoadSample4<T>(&srcspan[i*2 + 4]);
+#if HAVE_SSE_INTRINSICS
+            _mm_storeu_ps(&dst[i], channel ? _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3,1,3,1))
+                : _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2,0,2,0)));
+#else
+            vst1q_f32(&dst[i], channel ? vuzpq_f32(s0, s1).val[1] : vuzpq_f32(s0, s1).val[0]);
+#endif
+        }
+    }
+#endif
+    for(;i < dst.size();++i)
+        dst[i] = LoadSample<T>(srcspan[i*srcstep + channel]);
 }
 
 void LoadSamples(const std::span<float> dst, const void *src, const size_t channel,
@@ -98,22 +227,110 @@ template<> inline uint16_t StoreSample<DevFmtUShort>(float val) noexcept
 template<> inline uint8_t StoreSample<DevFmtUByte>(float val) noexcept
 { return static_cast<uint8_t>(StoreSample<DevFmtByte>(val) + 128); }
 
+#if HAVE_SSE_INTRINSICS
+/* Stores 4 consecutive samples, giving the same results as StoreSample. NEON
+ * stays with the scalar path, as ARMv7 has no round-to-nearest conversion to
+ * match fastf2i with.
+ */
+template<DevFmtType T>
+void StoreSample4(DevFmtType_t<T> *dst, __m128 val) noexcept
+{
+    using SampleType = DevFmtType_t<T>;
+    if constexpr(T == DevFmtFloat)
+        _mm_storeu_ps(dst, val);
+    else
+    {
+        constexpr auto scale = SampleScale<T>;
+        constexpr auto maxval = (sizeof(SampleType) == 4) ? 2147483520.0f : scale-1.0f;
+        val = _mm_max_ps(_mm_mul_ps(val, _mm_set1_ps(scale)), _mm_set1_ps(-scale));
+        auto ival = _mm_cvtps_epi32(_mm_min_ps(val, _mm_set1_ps(maxval)));
+        if constexpr(sizeof(SampleType) == 4)
+        {
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi32(std::numeric_limits<int32_t>::min()));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), ival);
+        }
+        else if constexpr(sizeof(SampleType) == 2)
+        {
+            ival = _mm_packs_epi32(ival, ival);
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi16(std::numeric_limits<int16_t>::min()));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), ival);
+        }
+        else
+        {
+            ival = _mm_packs_epi16(_mm_packs_epi32(ival, ival), ival);
+            if constexpr(std::is_unsigned_v<SampleType>)
+                ival = _mm_xor_si128(ival, _mm_set1_epi8(std::numeric_limits<int8_t>::min()));
+            const auto bytes = _mm_cvtsi128_si32(ival);
+            std::memcpy(dst, &bytes, sizeof(bytes));
+        }
+    }
+}
+#endif
+
 template<DevFmtType T>
 inline void StoreSampleArray(void *dst, const std::span<const float> src, const size_t channel,
     const size_t dststep) noexcept
 {
     assert(channel < dststep);
     const auto dstspan = std::span{static_cast<DevFmtType_t<T>*>(dst), src.size()*dststep};
-    auto sdst = dstspan.begin() + ptrdiff_t(channel);
-    *sdst = StoreSample<T>(src.front());
-    std::for_each(src.begin()+1, src.end(), [&sdst,dststep](const float in)
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    if(dststep == 1)
     {
-        sdst += ptrdiff_t(dststep);
-        *sdst = StoreSample<T>(in);
-    });
+        const auto todo = src.size() & ~3_uz;
+        for(;i < todo;i += 4)
+            StoreSample4<T>(&dstspan[i], _mm_loadu_ps(&src[i]));
+    }
+#endif
+    for(;i < src.size();++i)
+        dstspan[i*dststep + channel] = StoreSample<T>(src[i]);
 }
 
 
+/* Stores two channels as interleaved stereo. */
+template<DevFmtType T>
+inline void StoreStereoSampleArray(void *dst, const std::span<const float> src0,
+    const std::span<const float> src1) noexcept
+{
+    const auto dstspan = std::span{static_cast<DevFmtType_t<T>*>(dst), src0.size()*2};
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = src0.size() & ~3_uz;
+    for(;i < todo;i += 4)
+    {
+        const auto s0 = _mm_loadu_ps(&src0[i]);
+        const auto s1 = _mm_loadu_ps(&src1[i]);
+        StoreSample4<T>(&dstspan[i*2], _mm_unpacklo_ps(s0, s1));
+        StoreSample4<T>(&dstspan[i*2 + 4], _mm_unpackhi_ps(s0, s1));
+    }
+#endif
+    for(;i < src0.size();++i)
+    {
+        dstspan[i*2] = StoreSample<T>(src0[i]);
+        dstspan[i*2 + 1] = StoreSample<T>(src1[i]);
+    }
+}
+
+void StoreStereoSamples(void *dst, const std::span<const float> src0,
+    const std::span<const float> src1, const DevFmtType dsttype) noexcept
+{
+#define HANDLE_FMT(T)                                                         \
+    case T: StoreStereoSampleArray<T>(dst, src0, src1); break
+    switch(dsttype)
+    {
+        HANDLE_FMT(DevFmtByte);
+        HANDLE_FMT(DevFmtUByte);
+        HANDLE_FMT(DevFmtShort);
+        HANDLE_FMT(DevFmtUShort);
+        HANDLE_FMT(DevFmtInt);
+        HANDLE_FMT(DevFmtUInt);
+        HANDLE_FMT(DevFmtFloat);
+    }
+#undef HANDLE_FMT
+}
+
 void StoreSamples(void *dst, const std::span<const float> src, const size_t channel,
     const size_t dststep, const DevFmtType dsttype) noexcept
 {
@@ -136,33 +353,163 @@ void StoreSamples(void *dst, const std::span<const float> src, const size_t chan
 template<DevFmtType T>
 void Mono2Stereo(const std::span<float> dst, const void *src) noexcept
 {
+    static constexpr auto scale = 0.707106781187f;
     const auto srcspan = std::span{static_cast<const DevFmtType_t<T>*>(src), dst.size()>>1};
-    auto sdst = dst.begin();
-    std::for_each(srcspan.begin(), srcspan.end(), [&sdst](const auto in)
-    { sdst = std::fill_n(sdst, 2, LoadSample<T>(in)*0.707106781187f); });
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = srcspan.size() & ~3_uz;
+    for(;i < todo;i += 4)
+    {
+        const auto s = _mm_mul_ps(LoadSample4<T>(&srcspan[i]), _mm_set1_ps(scale));
+        _mm_storeu_ps(&dst[i*2], _mm_unpacklo_ps(s, s));
+        _mm_storeu_ps(&dst[i*2 + 4], _mm_unpackhi_ps(s, s));
+    }
+#elif HAVE_NEON
+    const auto todo = srcspan.size() & ~3_uz;
+    for(;i < todo;i += 4)
+    {
+        const auto s = vmulq_n_f32(LoadSample4<T>(&srcspan[i]), scale);
+        vst2q_f32(&dst[i*2], float32x4x2_t{{s, s}});
+    }
+#endif
+    for(;i < srcspan.size();++i)
+        dst[i*2] = dst[i*2 + 1] = LoadSample<T>(srcspan[i]) * scale;
 }
 
 template<DevFmtType T>
-void Multi2Mono(uint chanmask, const size_t step, const std::span<float> dst, const void *src)
-    noexcept
+void Multi2Mono(const uint chanmask, const size_t step, const std::span<float> dst,
+    const void *src) noexcept
 {
     const auto scale = std::sqrt(1.0f / static_cast<float>(std::popcount(chanmask)));
     const auto srcspan = std::span{static_cast<const DevFmtType_t<T>*>(src), step*dst.size()};
-    std::fill_n(dst.begin(), dst.size(), 0.0f);
-    while(chanmask)
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Stereo to mono is common enough to do in one pass. */
+    if(step == 2 && chanmask == 0x3)
+    {
+        auto i = 0_uz;
+        const auto todo = dst.size() & ~3_uz;
+        for(;i < todo;i += 4)
+        {
+            const auto s0 = LoadSample4<T>(&srcspan[i*2]);
+            const auto s1 = LoadSample4<T>(&srcspan[i*2 + 4]);
+#if HAVE_SSE_INTRINSICS
+            const auto left = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(2,0,2,0));
+            const auto right = _mm_shuffle_ps(s0, s1, _MM_SHUFFLE(3,1,3,1));
+            _mm_storeu_ps(&dst[i], _mm_mul_ps(_mm_add_ps(left, right), _mm_set1_ps(scale)));
+#else
+            const auto lr = vuzpq_f32(s0, s1);
+            vst1q_f32(&dst[i], vmulq_n_f32(vaddq_f32(lr.val[0], lr.val[1]), scale));
+#endif
+        }
+        for(;i < dst.size();++i)
+            dst[i] = (LoadSample<T>(srcspan[i*2]) + LoadSample<T>(srcspan[i*2 + 1])) * scale;
+        return;
+    }
+#endif
+
+    /* Load the first channel directly into the output, then accumulate the
+     * rest through a temporary buffer so each channel can use the vectorized
+     * loader.
+     */
+    alignas(16) std::array<float,256> temp{};
+    for(auto base = 0_uz;base < dst.size();base += temp.size())
     {
-        const auto c = std::countr_zero(chanmask);
-        chanmask ^= 1 << c;
+        const auto out = dst.subspan(base, std::min(temp.size(), dst.size()-base));
+        const auto in = srcspan.subspan(base*step).data();
+
+        auto mask = chanmask;
+        auto c = std::countr_zero(mask);
+        mask ^= 1u << c;
+        LoadSampleArray<T>(out, in, static_cast<size_t>(c), step);
+        while(mask)
+        {
+            c = std::countr_zero(mask);
+            mask ^= 1u << c;
+
+            const auto tmp = std::span{temp}.first(out.size());
+            LoadSampleArray<T>(tmp, in, static_cast<size_t>(c), step);
+            std::transform(out.begin(), out.end(), tmp.begin(), out.begin(), std::plus{});
+        }
+        std::transform(out.begin(), out.end(), out.begin(),
+            [scale](const float sample) noexcept { return sample * scale; });
+    }
+}
+
+
+/* Resamples two channels with the fast bsinc filter, calculating the phase-
+ * interpolated filter once for both. This matches running
+ * Resample_<FastBSincTag,...> on each channel separately.
+ */
+void ResampleFastBSincPair(const InterpState *state, const std::span<const float> src0,
+    const std::span<const float> src1, uint frac, const uint increment,
+    const std::span<float> dst0, const std::span<float> dst1)
+{
+    const auto &bsinc = std::get<BsincState>(*state);
+    const auto m = size_t{bsinc.m};
+    ASSUME(m > 0);
+    ASSUME(m <= MaxResamplerPadding);
+    ASSUME(frac < MixerFracOne);
+
+    const auto filter = bsinc.filter.first(2_uz*BSincPhaseCount*m);
 
-        auto ssrc = srcspan.begin() + c;
-        dst.front() += LoadSample<T>(*ssrc);
-        std::for_each(dst.begin(), dst.end(), [&ssrc,step](float &sample)
+    ASSUME(bsinc.l <= MaxResamplerEdge);
+    auto pos = size_t{MaxResamplerEdge-bsinc.l};
+    for(size_t i{0};i < dst0.size();++i)
+    {
+        // Calculate the phase index and factor.
+        const size_t pi{frac >> BSincPhaseDiffBits}; ASSUME(pi < BSincPhaseCount);
+        const float pf{static_cast<float>(frac&BSincPhaseDiffMask) * (1.0f/BSincPhaseDiffOne)};
+
+        const auto fil = filter.subspan(2_uz*pi*m);
+        const auto phd = fil.subspan(m);
+#if HAVE_SSE_INTRINSICS
+        auto r0 = _mm_setzero_ps();
+        auto r1 = _mm_setzero_ps();
+        const auto pf4 = _mm_set1_ps(pf);
+        for(size_t j{0};j < m;j += 4)
         {
-            ssrc += ptrdiff_t(step);
-            sample += LoadSample<T>(*ssrc);
-        });
+            /* f = fil + pf*phd */
+            const auto f4 = _mm_add_ps(_mm_load_ps(&fil[j]), _mm_mul_ps(pf4, _mm_load_ps(&phd[j])));
+            /* r += f*src */
+            r0 = _mm_add_ps(r0, _mm_mul_ps(f4, _mm_loadu_ps(&src0[pos+j])));
+            r1 = _mm_add_ps(r1, _mm_mul_ps(f4, _mm_loadu_ps(&src1[pos+j])));
+        }
+        r0 = _mm_add_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(0, 1, 2, 3)));
+        r1 = _mm_add_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(0, 1, 2, 3)));
+        dst0[i] = _mm_cvtss_f32(_mm_add_ps(r0, _mm_movehl_ps(r0, r0)));
+        dst1[i] = _mm_cvtss_f32(_mm_add_ps(r1, _mm_movehl_ps(r1, r1)));
+#elif HAVE_NEON
+        auto r0 = vdupq_n_f32(0.0f);
+        auto r1 = vdupq_n_f32(0.0f);
+        const auto pf4 = vdupq_n_f32(pf);
+        for(size_t j{0};j < m;j += 4)
+        {
+            const auto f4 = vmlaq_f32(vld1q_f32(&fil[j]), pf4, vld1q_f32(&phd[j]));
+            r0 = vmlaq_f32(r0, f4, vld1q_f32(&src0[pos+j]));
+            r1 = vmlaq_f32(r1, f4, vld1q_f32(&src1[pos+j]));
+        }
+        r0 = vaddq_f32(r0, vrev64q_f32(r0));
+        r1 = vaddq_f32(r1, vrev64q_f32(r1));
+        dst0[i] = vget_lane_f32(vadd_f32(vget_low_f32(r0), vget_high_f32(r0)), 0);
+        dst1[i] = vget_lane_f32(vadd_f32(vget_low_f32(r1), vget_high_f32(r1)), 0);
+#else
+        auto r0 = 0.0f;
+        auto r1 = 0.0f;
+        for(size_t j{0};j < m;++j)
+        {
+            const auto f = fil[j] + pf*phd[j];
+            r0 += f * src0[pos+j];
+            r1 += f * src1[pos+j];
+        }
+        dst0[i] = r0;
+        dst1[i] = r1;
+#endif
+
+        frac += increment;
+        pos  += frac>>MixerFracBits;
+        frac &= MixerFracMask;
     }
-    std::for_each(dst.begin(), dst.end(), [scale](float &sample) noexcept { sample *= scale; });
 }
 
 } // namespace
@@ -197,9 +544,33 @@ SampleConverterPtr SampleConverter::Create(DevFmtType srcType, DevFmtType dstTyp
         { std::copy_n(src.begin()+MaxResamplerEdge, dst.size(), dst.begin()); };
     }
     else
+    {
         converter->mResample = PrepareResampler(resampler, converter->mIncrement,
             &converter->mState);
 
+        /* The fast bsinc resampler, which bsinc also uses when not
+         * downsampling, can process channels in pairs.
+         */
+        switch(resampler)
+        {
+        case Resampler::FastBSinc12:
+        case Resampler::FastBSinc24:
+        case Resampler::FastBSinc48:
+            converter->mPairedResample = true;
+            break;
+        case Resampler::BSinc12:
+        case Resampler::BSinc24:
+        case Resampler::BSinc48:
+            converter->mPairedResample = converter->mIncrement <= MixerFracOne;
+            break;
+        case Resampler::Point:
+        case Resampler::Linear:
+        case Resampler::Spline:
+        case Resampler::Gaussian:
+            break;
+        }
+    }
+
     return converter;
 }
 
@@ -259,8 +630,6 @@ uint SampleConverter::convert(const void **src, uint *srcframes, void *dst, uint
             break;
         }
 
-        const auto SrcData = std::span<float>{mSrcSamples};
-        const auto DstData = std::span<float>{mDstSamples};
         uint DataPosFrac{mFracOffset};
         uint64_t DataSize64{prepcount};
         DataSize64 += readable;
@@ -279,26 +648,43 @@ uint SampleConverter::convert(const void **src, uint *srcframes, void *dst, uint
         assert(prepcount+readable >= SrcDataEnd);
         const uint nextprep{std::min(prepcount+readable-SrcDataEnd, MaxResamplerPadding)};
 
-        for(size_t chan{0u};chan < mChan.size();chan++)
+        for(size_t chan{0u};chan < mChan.size();)
         {
-            /* Load the previous samples into the source data first, then the
-             * new samples from the input buffer.
-             */
-            std::copy_n(mChan[chan].PrevSamples.cbegin(), prepcount, SrcData.begin());
-            LoadSamples(SrcData.subspan(prepcount, readable), SamplesIn.data(), chan, mChan.size(),
-                mSrcType);
-
-            /* Store as many prep samples for next time as possible, given the
-             * number of output samples being generated.
-             */
-            auto previter = std::copy_n(SrcData.begin()+ptrdiff_t(SrcDataEnd), nextprep,
-                mChan[chan].PrevSamples.begin());
-            std::fill(previter, mChan[chan].PrevSamples.end(), 0.0f);
+            const auto count = (mPairedResample && mChan.size()-chan > 1) ? 2_uz : 1_uz;
+            for(size_t c{0u};c < count;++c)
+            {
+                /* Load the previous samples into the source data first, then
+                 * the new samples from the input buffer.
+                 */
+                const auto SrcData = std::span{mSrcSamples[c]};
+                std::copy_n(mChan[chan+c].PrevSamples.cbegin(), prepcount, SrcData.begin());
+                LoadSamples(SrcData.subspan(prepcount, readable), SamplesIn.data(), chan+c,
+                    mChan.size(), mSrcType);
+
+                /* Store as many prep samples for next time as possible, given
+                 * the number of output samples being generated.
+                 */
+                auto previter = std::copy_n(SrcData.begin()+ptrdiff_t(SrcDataEnd), nextprep,
+                    mChan[chan+c].PrevSamples.begin());
+                std::fill(previter, mChan[chan+c].PrevSamples.end(), 0.0f);
+            }
 
             /* Now resample, and store the result in the output buffer. */
-            mResample(&mState, SrcData, DataPosFrac, increment, DstData.first(DstSize));
-
-            StoreSamples(SamplesOut.data(), DstData.first(DstSize), chan, mChan.size(), mDstType);
+            if(count == 2)
+                ResampleFastBSincPair(&mState, mSrcSamples[0], mSrcSamples[1], DataPosFrac,
+                    increment, std::span{mDstSamples[0]}.first(DstSize),
+                    std::span{mDstSamples[1]}.first(DstSize));
+            else
+                mResample(&mState, mSrcSamples[0], DataPosFrac, increment,
+                    std::span{mDstSamples[0]}.first(DstSize));
+
+            if(count == 2 && mChan.size() == 2)
+                StoreStereoSamples(SamplesOut.data(), std::span{mDstSamples[0]}.first(DstSize),
+                    std::span{mDstSamples[1]}.first(DstSize), mDstType);
+            else for(size_t c{0u};c < count;++c)
+                StoreSamples(SamplesOut.data(), std::span{mDstSamples[c]}.first(DstSize), chan+c,
+                    mChan.size(), mDstType);
+            chan += count;
         }
 
         /* Update the number of prep samples still available, as well as the
@@ -355,8 +741,6 @@ uint SampleConverter::convertPlanar(const void **src, uint *srcframes, void *con
             break;
         }
 
-        const auto SrcData = std::span{mSrcSamples};
-        const auto DstData = std::span{mDstSamples};
         uint DataPosFrac{mFracOffset};
         uint64_t DataSize64{prepcount};
         DataSize64 += readable;
@@ -375,27 +759,44 @@ uint SampleConverter::convertPlanar(const void **src, uint *srcframes, void *con
         assert(prepcount+readable >= SrcDataEnd);
         const uint nextprep{std::min(prepcount+readable-SrcDataEnd, MaxResamplerPadding)};
 
-        for(size_t chan{0u};chan < mChan.size();chan++)
+        for(size_t chan{0u};chan < mChan.size();)
         {
-            /* Load the previous samples into the source data first, then the
-             * new samples from the input buffer.
-             */
-            auto srciter = std::copy_n(mChan[chan].PrevSamples.cbegin(),prepcount,SrcData.begin());
-            LoadSamples({srciter, readable}, srcs[chan], 0, 1, mSrcType);
-
-            /* Store as many prep samples for next time as possible, given the
-             * number of output samples being generated.
-             */
-            auto previter = std::copy_n(SrcData.begin()+ptrdiff_t(SrcDataEnd), nextprep,
-                mChan[chan].PrevSamples.begin());
-            std::fill(previter, mChan[chan].PrevSamples.end(), 0.0f);
+            const auto count = (mPairedResample && mChan.size()-chan > 1) ? 2_uz : 1_uz;
+            for(size_t c{0u};c < count;++c)
+            {
+                /* Load the previous samples into the source data first, then
+                 * the new samples from the input buffer.
+                 */
+                const auto SrcData = std::span{mSrcSamples[c]};
+                auto srciter = std::copy_n(mChan[chan+c].PrevSamples.cbegin(), prepcount,
+                    SrcData.begin());
+                LoadSamples({srciter, readable}, srcs[chan+c], 0, 1, mSrcType);
+
+                /* Store as many prep samples for next time as possible, given
+                 * the number of output samples being generated.
+                 */
+                auto previter = std::copy_n(SrcData.begin()+ptrdiff_t(SrcDataEnd), nextprep,
+                    mChan[chan+c].PrevSamples.begin());
+                std::fill(previter, mChan[chan+c].PrevSamples.end(), 0.0f);
+            }
 
             /* Now resample, and store the result in the output buffer. */
-            mResample(&mState, SrcData, DataPosFrac, increment, DstData.first(DstSize));
-
-            auto DstSamples = std::span{static_cast<std::byte*>(dsts[chan]),
-                size_t{mDstTypeSize}*dstframes}.subspan(pos*size_t{mDstTypeSize});
-            StoreSamples(DstSamples.data(), DstData.first(DstSize), 0, 1, mDstType);
+            if(count == 2)
+                ResampleFastBSincPair(&mState, mSrcSamples[0], mSrcSamples[1], DataPosFrac,
+                    increment, std::span{mDstSamples[0]}.first(DstSize),
+                    std::span{mDstSamples[1]}.first(DstSize));
+            else
+                mResample(&mState, mSrcSamples[0], DataPosFrac, increment,
+                    std::span{mDstSamples[0]}.first(DstSize));
+
+            for(size_t c{0u};c < count;++c)
+            {
+                auto DstSamples = std::span{static_cast<std::byte*>(dsts[chan+c]),
+                    size_t{mDstTypeSize}*dstframes}.subspan(pos*size_t{mDstTypeSize});
+                StoreSamples(DstSamples.data(), std::span{mDstSamples[c]}.first(DstSize), 0, 1,
+                    mDstType);
+            }
+            chan += count;
         }
 
         /* Update the number of prep samples still available, as well as the
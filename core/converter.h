@@ -1,6 +1,7 @@
 #ifndef CORE_CONVERTER_H
 #define CORE_CONVERTER_H
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <memory>
@@ -27,8 +28,10 @@ struct SampleConverter {
     InterpState mState;
     ResamplerFunc mResample{};
 
-    alignas(16) FloatBufferLine mSrcSamples{};
-    alignas(16) FloatBufferLine mDstSamples{};
+    /* Channels are resampled in pairs when the resampler allows it. */
+    alignas(16) std::array<FloatBufferLine,2> mSrcSamples{};
+    alignas(16) std::array<FloatBufferLine,2> mDstSamples{};
+    bool mPairedResample{};
 
     struct ChanSamples {
         alignas(16) std::array<float,MaxResamplerPadding> PrevSamples;
@@ -33,6 +33,7 @@ struct bs2b;
 class Compressor;
 struct ContextBase;
 struct DirectHrtfState;
+class HrtfCoeffCache;
 struct HrtfStore;
 
 using uint = unsigned int;
@@ -243,6 +244,9 @@ struct SIMDALIGN DeviceBase {
     alignas(16) std::array<float,BufferLineSize> FilteredData{};
     alignas(16) std::array<float,BufferLineSize+HrtfHistoryLength> ExtraSampleData{};
 
+    /* Near-field control filter output, a line for each ambisonic order. */
+    alignas(16) std::array<float,BufferLineSize*MaxAmbiOrder> NfcSampleData{};
+
     /* Persistent storage for HRTF mixing. */
     alignas(16) std::array<float2,BufferLineSize+HrirLength> HrtfAccumData{};
 
@@ -261,6 +265,7 @@ struct SIMDALIGN DeviceBase {
     /* HRTF state and info */
     std::unique_ptr<DirectHrtfState> mHrtfState;
     al::intrusive_ptr<HrtfStore> mHrtf;
+    std::unique_ptr<HrtfCoeffCache> mHrtfCache;
     uint mIrSize{0};
 
     /* Ambisonic-to-UHJ encoder */
@@ -291,6 +296,27 @@ struct SIMDALIGN DeviceBase {
      */
     std::atomic<uint> mMixCount{0u};
 
+    /* Output hold, for reconfiguring the renderer while the backend keeps
+     * running. A requested hold makes the mixer fade out over its next update
+     * and then write silence without touching the renderer, until released to
+     * fade back in. The held updates leave a silent gap in the output. Sources
+     * don't progress during it, though the device clock keeps counting the
+     * samples written.
+     */
+    enum class OutputHold : std::uint8_t {
+        None,
+        Requested,
+        Held,
+        Releasing
+    };
+    std::atomic<OutputHold> mOutputHold{OutputHold::None};
+
+    /* A disconnect reported while the output is held, left for the renderer
+     * update to handle once the mixer is stopped.
+     */
+    std::atomic<bool> mDisconnectPending{false};
+    std::string mPendingDisconnectMsg;
+
     // Contexts created on this device
     using ContextArray = al::FlexArray<ContextBase*>;
     al::atomic_unique_ptr<ContextArray> mContexts;
@@ -358,9 +384,18 @@ struct SIMDALIGN DeviceBase {
     void renderSamples(const std::span<void*> outBuffers, const uint numSamples);
     void renderSamples(void *outBuffer, const uint numSamples, const std::size_t frameStep);
 
-    /* Caller must lock the device state, and the mixer must not be running. */
+    /* Caller must lock the device state, and the mixer must not be running.
+     * When called while the output is held for a renderer update, the
+     * disconnect is left pending for the update to handle.
+     */
     void doDisconnect(std::string msg);
 
+    /**
+     * Handles a disconnect left pending by doDisconnect. The mixer must not be
+     * running. Returns true if there was one.
+     */
+    bool handlePendingDisconnect();
+
     template<typename ...Args>
     void handleDisconnect(fmt::format_string<Args...> fmt, Args&& ...args)
     { doDisconnect(fmt::format(std::move(fmt), std::forward<Args>(args)...)); }
@@ -374,6 +409,9 @@ struct SIMDALIGN DeviceBase {
 
 private:
     uint renderSamples(const uint numSamples);
+    void advanceClock(const uint samplesToDo) noexcept;
+    void fadeOutputHold(const OutputHold hold, const uint samplesToDo);
+    void advanceOutputHold(OutputHold hold) noexcept;
 
 protected:
     explicit DeviceBase(DeviceType type);
@@ -119,6 +119,8 @@ public:
     /* Rather hacky. It's just here to support "manual" processing. */
     [[nodiscard]] auto getComponents() const noexcept -> std::array<float,2> { return {mZ1,mZ2}; }
     void setComponents(float z1, float z2) noexcept { mZ1 = z1; mZ2 = z2; }
+    [[nodiscard]] auto getCoeffs() const noexcept -> std::array<float,5>
+    { return {mB0, mB1, mB2, mA1, mA2}; }
     [[nodiscard]] auto processOne(const float in, float &z1, float &z2) const noexcept -> float
     {
         const auto out = in*mB0 + z1;
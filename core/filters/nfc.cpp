@@ -1,9 +1,19 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "nfc.h"
 
 #include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
 
 
 /* Near-field control filters are the basis for handling the near-field effect.
@@ -228,6 +238,65 @@ void NfcFilterAdjust4(NfcFilter4 *nfc, const float w0) noexcept
     nfc->b4 = 4.0f * b_01 / g_0;
 }
 
+#if HAVE_SSE_INTRINSICS
+
+using float4 = __m128;
+inline auto Load4(const std::array<float,4> &vals) noexcept -> __m128
+{ return _mm_loadu_ps(vals.data()); }
+inline auto Splat4(const float val) noexcept -> __m128 { return _mm_set1_ps(val); }
+inline void Store4(float *dst, const __m128 val) noexcept { _mm_storeu_ps(dst, val); }
+inline auto Add4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_add_ps(a, b); }
+inline auto Sub4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_sub_ps(a, b); }
+inline auto Mul4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_mul_ps(a, b); }
+inline auto And4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_and_ps(a, b); }
+
+/* Returns a mask for the lanes starting at the given one. */
+inline auto LaneMask4(const int first) noexcept -> __m128
+{
+    return _mm_castsi128_ps(_mm_setr_epi32(first > 0 ? 0 : -1, first > 1 ? 0 : -1,
+        first > 2 ? 0 : -1, -1));
+}
+
+inline void Transpose4(__m128 &r0, __m128 &r1, __m128 &r2, __m128 &r3) noexcept
+{ _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+#elif HAVE_NEON
+
+using float4 = float32x4_t;
+inline auto Load4(const std::array<float,4> &vals) noexcept -> float32x4_t
+{ return vld1q_f32(vals.data()); }
+inline auto Splat4(const float val) noexcept -> float32x4_t { return vdupq_n_f32(val); }
+inline void Store4(float *dst, const float32x4_t val) noexcept { vst1q_f32(dst, val); }
+inline auto Add4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vaddq_f32(a, b); }
+inline auto Sub4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vsubq_f32(a, b); }
+inline auto Mul4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vmulq_f32(a, b); }
+inline auto And4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{
+    return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a),
+        vreinterpretq_u32_f32(b)));
+}
+
+inline auto LaneMask4(const int first) noexcept -> float32x4_t
+{
+    const auto mask = std::array<uint32_t,4>{first > 0 ? 0u : ~0u, first > 1 ? 0u : ~0u,
+        first > 2 ? 0u : ~0u, ~0u};
+    return vreinterpretq_f32_u32(vld1q_u32(mask.data()));
+}
+
+inline void Transpose4(float32x4_t &r0, float32x4_t &r1, float32x4_t &r2, float32x4_t &r3) noexcept
+{
+    const auto t01 = vtrnq_f32(r0, r1);
+    const auto t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
 } // namespace
 
 void NfcFilter::init(const float w1) noexcept
@@ -350,3 +419,101 @@ void NfcFilter::process4(const std::span<const float> src, const std::span<float
     fourth.z[2] = z3;
     fourth.z[3] = z4;
 }
+
+void NfcFilter::processAll(const std::span<const float> src, const std::span<float> dst)
+{
+    const auto count = src.size();
+    assert(dst.size() >= count*4);
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Each order's filter runs in its own lane, using the fourth-order
+     * structure (two second-order sections). Terms the lower orders don't
+     * have get zero coefficients, and their history is masked so it stays
+     * zero, which leaves the lower-order lanes with the same results as their
+     * scalar filters.
+     */
+    const auto zmask2 = LaneMask4(1);
+    const auto zmask3 = LaneMask4(2);
+    const auto zmask4 = LaneMask4(3);
+
+    const auto gain = Load4({first.gain, second.gain, third.gain, fourth.gain});
+    const auto b1 = Load4({first.b1, second.b1, third.b1, fourth.b1});
+    const auto b2 = Load4({0.0f, second.b2, third.b2, fourth.b2});
+    const auto b3 = Load4({0.0f, 0.0f, third.b3, fourth.b3});
+    const auto b4 = Load4({0.0f, 0.0f, 0.0f, fourth.b4});
+    const auto a1 = Load4({first.a1, second.a1, third.a1, fourth.a1});
+    const auto a2 = Load4({0.0f, second.a2, third.a2, fourth.a2});
+    const auto a3 = Load4({0.0f, 0.0f, third.a3, fourth.a3});
+    const auto a4 = Load4({0.0f, 0.0f, 0.0f, fourth.a4});
+    auto z1 = Load4({first.z[0], second.z[0], third.z[0], fourth.z[0]});
+    auto z2 = Load4({0.0f, second.z[1], third.z[1], fourth.z[1]});
+    auto z3 = Load4({0.0f, 0.0f, third.z[2], fourth.z[2]});
+    auto z4 = Load4({0.0f, 0.0f, 0.0f, fourth.z[3]});
+
+    auto proc_sample = [=,&z1,&z2,&z3,&z4](const float4 in) noexcept -> float4
+    {
+        auto y = Sub4(Sub4(Mul4(in, gain), Mul4(a1, z1)), Mul4(a2, z2));
+        auto out = Add4(Add4(y, Mul4(b1, z1)), Mul4(b2, z2));
+        z2 = Add4(z2, And4(z1, zmask2));
+        z1 = Add4(z1, y);
+
+        y = Sub4(Sub4(out, Mul4(a3, z3)), Mul4(a4, z4));
+        out = Add4(Add4(y, Mul4(b3, z3)), Mul4(b4, z4));
+        z4 = Add4(z4, And4(z3, zmask4));
+        z3 = Add4(z3, And4(y, zmask3));
+        return out;
+    };
+
+    const auto dst1 = dst.first(count);
+    const auto dst2 = dst.subspan(count, count);
+    const auto dst3 = dst.subspan(count*2, count);
+    const auto dst4 = dst.subspan(count*3, count);
+
+    /* Process four samples at a time, transposing the results so each vector
+     * holds four samples of one order.
+     */
+    size_t i{0};
+    for(;count-i >= 4;i += 4)
+    {
+        auto r0 = proc_sample(Splat4(src[i]));
+        auto r1 = proc_sample(Splat4(src[i+1]));
+        auto r2 = proc_sample(Splat4(src[i+2]));
+        auto r3 = proc_sample(Splat4(src[i+3]));
+        Transpose4(r0, r1, r2, r3);
+        Store4(&dst1[i], r0);
+        Store4(&dst2[i], r1);
+        Store4(&dst3[i], r2);
+        Store4(&dst4[i], r3);
+    }
+    for(;i < count;++i)
+    {
+        auto outvals = std::array<float,4>{};
+        Store4(outvals.data(), proc_sample(Splat4(src[i])));
+        dst1[i] = outvals[0];
+        dst2[i] = outvals[1];
+        dst3[i] = outvals[2];
+        dst4[i] = outvals[3];
+    }
+
+    auto zvals = std::array<float,4>{};
+    Store4(zvals.data(), z1);
+    first.z[0] = zvals[0];
+    second.z[0] = zvals[1];
+    third.z[0] = zvals[2];
+    fourth.z[0] = zvals[3];
+    Store4(zvals.data(), z2);
+    second.z[1] = zvals[1];
+    third.z[1] = zvals[2];
+    fourth.z[1] = zvals[3];
+    Store4(zvals.data(), z3);
+    third.z[2] = zvals[2];
+    fourth.z[2] = zvals[3];
+    Store4(zvals.data(), z4);
+    fourth.z[3] = zvals[3];
+#else
+    process1(src, dst.first(count));
+    process2(src, dst.subspan(count, count));
+    process3(src, dst.subspan(count*2, count));
+    process4(src, dst.subspan(count*3, count));
+#endif
+}
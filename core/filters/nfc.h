@@ -57,6 +57,13 @@ public:
 
     /* Near-field control filter for fourth-order ambisonic channels (16-24). */
     void process4(const std::span<const float> src, const std::span<float> dst);
+
+    /* Near-field control filters for the first- through fourth-order
+     * channels, applied to the same input together. dst receives src.size()
+     * samples for each order, one after the other. Produces the same output
+     * as process1 through process4.
+     */
+    void processAll(const std::span<const float> src, const std::span<float> dst);
 };
 
 #endif /* CORE_FILTERS_NFC_H */
@@ -1,14 +1,183 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "splitter.h"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <limits>
 #include <numbers>
 
+#include "alnumeric.h"
+
+#if HAVE_SSE_INTRINSICS
+#include <xmmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
+
+namespace {
+
+#if HAVE_SSE_INTRINSICS
+
+using float4 = __m128;
+inline auto Load4(const float *src) noexcept -> __m128 { return _mm_loadu_ps(src); }
+inline void Store4(float *dst, const __m128 val) noexcept { _mm_storeu_ps(dst, val); }
+inline auto Add4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_add_ps(a, b); }
+inline auto Sub4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_sub_ps(a, b); }
+inline auto Mul4(const __m128 a, const __m128 b) noexcept -> __m128 { return _mm_mul_ps(a, b); }
+
+inline void Transpose4(__m128 &r0, __m128 &r1, __m128 &r2, __m128 &r3) noexcept
+{ _MM_TRANSPOSE4_PS(r0, r1, r2, r3); }
+
+#elif HAVE_NEON
+
+using float4 = float32x4_t;
+inline auto Load4(const float *src) noexcept -> float32x4_t { return vld1q_f32(src); }
+inline void Store4(float *dst, const float32x4_t val) noexcept { vst1q_f32(dst, val); }
+inline auto Add4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vaddq_f32(a, b); }
+inline auto Sub4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vsubq_f32(a, b); }
+inline auto Mul4(const float32x4_t a, const float32x4_t b) noexcept -> float32x4_t
+{ return vmulq_f32(a, b); }
+
+inline void Transpose4(float32x4_t &r0, float32x4_t &r1, float32x4_t &r2, float32x4_t &r3) noexcept
+{
+    const auto t01 = vtrnq_f32(r0, r1);
+    const auto t23 = vtrnq_f32(r2, r3);
+    r0 = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1 = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2 = vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3 = vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+#endif
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+
+using LaneArray = std::array<float,4>;
+
+struct SplitterLanes {
+    LaneArray ApCoeff{}, LpCoeff{};
+    LaneArray LpZ1{}, LpZ2{}, ApZ1{};
+    LaneArray HfScale{}, LfScale{};
+};
+
+/* Runs four band splitters in parallel, one per lane, using the same
+ * operations as the scalar versions so the results are identical. Lanes past
+ * numchans are duplicates of the last used channel, and their output is
+ * discarded. When Split is true, the high- and low-passed signals are written
+ * to hpout and lpout. Otherwise they're scaled and recombined in hpout.
+ */
+template<bool Split>
+void ProcessLanes(SplitterLanes &lanes, const std::array<const float*,4> &input,
+    const std::array<float*,4> &hpout, const std::array<float*,4> &lpout,
+    const size_t numchans, const size_t count) noexcept
+{
+    const auto ap_coeff = Load4(lanes.ApCoeff.data());
+    const auto lp_coeff = Load4(lanes.LpCoeff.data());
+    const auto hfscale = Load4(lanes.HfScale.data());
+    const auto lfscale = Load4(lanes.LfScale.data());
+    auto lp_z1 = Load4(lanes.LpZ1.data());
+    auto lp_z2 = Load4(lanes.LpZ2.data());
+    auto ap_z1 = Load4(lanes.ApZ1.data());
+
+    auto proc_sample = [ap_coeff,lp_coeff,&lp_z1,&lp_z2,&ap_z1](const float4 in, float4 &hp,
+        float4 &lp) noexcept
+    {
+        auto d = Mul4(Sub4(in, lp_z1), lp_coeff);
+        auto lp_y = Add4(lp_z1, d);
+        lp_z1 = Add4(lp_y, d);
+
+        d = Mul4(Sub4(lp_y, lp_z2), lp_coeff);
+        lp_y = Add4(lp_z2, d);
+        lp_z2 = Add4(lp_y, d);
+
+        const auto ap_y = Add4(Mul4(in, ap_coeff), ap_z1);
+        ap_z1 = Sub4(in, Mul4(ap_y, ap_coeff));
+
+        hp = Sub4(ap_y, lp_y);
+        lp = lp_y;
+    };
+
+    auto store_lanes = [numchans](const std::array<float*,4> &output, const size_t offset,
+        const float4 r0, const float4 r1, const float4 r2, const float4 r3) noexcept
+    {
+        Store4(output[0]+offset, r0);
+        if(numchans > 1) Store4(output[1]+offset, r1);
+        if(numchans > 2) Store4(output[2]+offset, r2);
+        if(numchans > 3) Store4(output[3]+offset, r3);
+    };
+
+    /* Four samples of each channel are loaded and transposed, so each vector
+     * holds one sample from all four channels, then transposed back for
+     * storing.
+     */
+    size_t i{0};
+    for(;count-i >= 4;i += 4)
+    {
+        auto in0 = Load4(input[0]+i);
+        auto in1 = Load4(input[1]+i);
+        auto in2 = Load4(input[2]+i);
+        auto in3 = Load4(input[3]+i);
+        Transpose4(in0, in1, in2, in3);
+
+        auto hp0 = float4{}, hp1 = float4{}, hp2 = float4{}, hp3 = float4{};
+        auto lp0 = float4{}, lp1 = float4{}, lp2 = float4{}, lp3 = float4{};
+        proc_sample(in0, hp0, lp0);
+        proc_sample(in1, hp1, lp1);
+        proc_sample(in2, hp2, lp2);
+        proc_sample(in3, hp3, lp3);
+        if constexpr(!Split)
+        {
+            hp0 = Add4(Mul4(hp0, hfscale), Mul4(lp0, lfscale));
+            hp1 = Add4(Mul4(hp1, hfscale), Mul4(lp1, lfscale));
+            hp2 = Add4(Mul4(hp2, hfscale), Mul4(lp2, lfscale));
+            hp3 = Add4(Mul4(hp3, hfscale), Mul4(lp3, lfscale));
+        }
+
+        Transpose4(hp0, hp1, hp2, hp3);
+        store_lanes(hpout, i, hp0, hp1, hp2, hp3);
+        if constexpr(Split)
+        {
+            Transpose4(lp0, lp1, lp2, lp3);
+            store_lanes(lpout, i, lp0, lp1, lp2, lp3);
+        }
+    }
+    for(;i < count;++i)
+    {
+        const auto invals = LaneArray{input[0][i], input[1][i], input[2][i], input[3][i]};
+        auto hp = float4{};
+        auto lp = float4{};
+        proc_sample(Load4(invals.data()), hp, lp);
+        if constexpr(!Split)
+            hp = Add4(Mul4(hp, hfscale), Mul4(lp, lfscale));
+
+        auto outvals = LaneArray{};
+        Store4(outvals.data(), hp);
+        for(size_t c{0};c < numchans;++c)
+            hpout[c][i] = outvals[c];
+        if constexpr(Split)
+        {
+            Store4(outvals.data(), lp);
+            for(size_t c{0};c < numchans;++c)
+                lpout[c][i] = outvals[c];
+        }
+    }
+
+    Store4(lanes.LpZ1.data(), lp_z1);
+    Store4(lanes.LpZ2.data(), lp_z2);
+    Store4(lanes.ApZ1.data(), ap_z1);
+}
+#endif
+
+} // namespace
+
+
 
 void BandSplitter::init(float f0norm)
 {
@@ -171,3 +340,100 @@ void BandSplitter::processAllPass(const std::span<float> samples)
     });
     mApZ1 = z1;
 }
+
+void BandSplitter::processGroup(const std::span<BandSplitter*const> splitters,
+    const std::span<const float*const> input, const std::span<float*const> hpout,
+    const std::span<float*const> lpout, const size_t count)
+{
+    assert(input.size() >= splitters.size());
+    assert(hpout.size() >= splitters.size());
+    assert(lpout.size() >= splitters.size());
+
+    size_t base{0};
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    while(splitters.size()-base > 1)
+    {
+        const auto numchans = std::min(splitters.size()-base, 4_uz);
+
+        auto lanes = SplitterLanes{};
+        auto inptrs = std::array<const float*,4>{};
+        auto hpptrs = std::array<float*,4>{};
+        auto lpptrs = std::array<float*,4>{};
+        for(size_t c{0};c < 4;++c)
+        {
+            const auto idx = base + std::min(c, numchans-1);
+            const auto &splitter = *splitters[idx];
+            lanes.ApCoeff[c] = splitter.mCoeff;
+            lanes.LpCoeff[c] = splitter.mCoeff*0.5f + 0.5f;
+            lanes.LpZ1[c] = splitter.mLpZ1;
+            lanes.LpZ2[c] = splitter.mLpZ2;
+            lanes.ApZ1[c] = splitter.mApZ1;
+            inptrs[c] = input[idx];
+            hpptrs[c] = hpout[idx];
+            lpptrs[c] = lpout[idx];
+        }
+
+        ProcessLanes<true>(lanes, inptrs, hpptrs, lpptrs, numchans, count);
+
+        for(size_t c{0};c < numchans;++c)
+        {
+            auto &splitter = *splitters[base+c];
+            splitter.mLpZ1 = lanes.LpZ1[c];
+            splitter.mLpZ2 = lanes.LpZ2[c];
+            splitter.mApZ1 = lanes.ApZ1[c];
+        }
+        base += numchans;
+    }
+#endif
+    for(;base < splitters.size();++base)
+        splitters[base]->process({input[base], count}, {hpout[base], count},
+            {lpout[base], count});
+}
+
+void BandSplitter::processScaleGroup(const std::span<BandSplitter*const> splitters,
+    const std::span<float*const> samples, const std::span<const float> hfscales,
+    const std::span<const float> lfscales, const size_t count)
+{
+    assert(samples.size() >= splitters.size());
+    assert(hfscales.size() >= splitters.size());
+    assert(lfscales.size() >= splitters.size());
+
+    size_t base{0};
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    while(splitters.size()-base > 1)
+    {
+        const auto numchans = std::min(splitters.size()-base, 4_uz);
+
+        auto lanes = SplitterLanes{};
+        auto inptrs = std::array<const float*,4>{};
+        auto outptrs = std::array<float*,4>{};
+        for(size_t c{0};c < 4;++c)
+        {
+            const auto idx = base + std::min(c, numchans-1);
+            const auto &splitter = *splitters[idx];
+            lanes.ApCoeff[c] = splitter.mCoeff;
+            lanes.LpCoeff[c] = splitter.mCoeff*0.5f + 0.5f;
+            lanes.LpZ1[c] = splitter.mLpZ1;
+            lanes.LpZ2[c] = splitter.mLpZ2;
+            lanes.ApZ1[c] = splitter.mApZ1;
+            lanes.HfScale[c] = hfscales[idx];
+            lanes.LfScale[c] = lfscales[idx];
+            inptrs[c] = samples[idx];
+            outptrs[c] = samples[idx];
+        }
+
+        ProcessLanes<false>(lanes, inptrs, outptrs, outptrs, numchans, count);
+
+        for(size_t c{0};c < numchans;++c)
+        {
+            auto &splitter = *splitters[base+c];
+            splitter.mLpZ1 = lanes.LpZ1[c];
+            splitter.mLpZ2 = lanes.LpZ2[c];
+            splitter.mApZ1 = lanes.ApZ1[c];
+        }
+        base += numchans;
+    }
+#endif
+    for(;base < splitters.size();++base)
+        splitters[base]->processScale({samples[base], count}, hfscales[base], lfscales[base]);
+}
@@ -1,6 +1,7 @@
 #ifndef CORE_FILTERS_SPLITTER_H
 #define CORE_FILTERS_SPLITTER_H
 
+#include <cstddef>
 #include <span>
 
 
@@ -33,6 +34,23 @@ public:
      * without splitting or scaling the signal.
      */
     void processAllPass(const std::span<float> samples);
+
+    /**
+     * Splits a group of channels, each with its own band splitter. Up to four
+     * channels are processed together, with each splitter's state in a
+     * separate SIMD lane.
+     */
+    static void processGroup(const std::span<BandSplitter*const> splitters,
+        const std::span<const float*const> input, const std::span<float*const> hpout,
+        const std::span<float*const> lpout, const std::size_t count);
+
+    /**
+     * Applies processScale to a group of channels, each with its own band
+     * splitter and scales. Processed the same as processGroup.
+     */
+    static void processScaleGroup(const std::span<BandSplitter*const> splitters,
+        const std::span<float*const> samples, const std::span<const float> hfscales,
+        const std::span<const float> lfscales, const std::size_t count);
 };
 
 #endif /* CORE_FILTERS_SPLITTER_H */
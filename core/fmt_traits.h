@@ -2,6 +2,7 @@
 #define CORE_FMT_TRAITS_H
 
 #include <array>
+#include <bit>
 #include <cstdint>
 
 #include "storage_formats.h"
@@ -131,6 +132,43 @@ struct FmtTypeTraits<FmtAlaw> {
     { return float(aLawDecompressionTable[val]) * (1.0f/32768.0f); }
 };
 
+template<>
+struct FmtTypeTraits<FmtHalf> {
+    using Type = std::uint16_t;
+
+    /* Rebiases the exponent and shifts the mantissa into place, handling
+     * subnormals by subtracting the implicit leading bit after normalizing as
+     * a float. This avoids operating on denormal floats.
+     */
+    constexpr float operator()(const Type val) const noexcept
+    {
+        constexpr auto ShiftedExp = 0x7c00u << 13;
+        auto bits = (val&0x7fffu) << 13;
+        const auto exp = bits & ShiftedExp;
+        bits += (127u-15u) << 23;
+        if(exp == ShiftedExp)
+            bits += (128u-16u) << 23;
+        else if(exp == 0)
+        {
+            bits += 1u << 23;
+            bits = std::bit_cast<std::uint32_t>(std::bit_cast<float>(bits)
+                - std::bit_cast<float>(113u << 23));
+        }
+        return std::bit_cast<float>(bits | ((val&0x8000u) << 16));
+    }
+};
+template<>
+struct FmtTypeTraits<FmtInt24> {
+    struct Type { std::array<std::uint8_t,3> bytes; };
+
+    constexpr float operator()(const Type val) const noexcept
+    {
+        const auto ival = static_cast<std::int32_t>((std::uint32_t{val.bytes[0]} << 8)
+            | (std::uint32_t{val.bytes[1]} << 16) | (std::uint32_t{val.bytes[2]} << 24)) >> 8;
+        return static_cast<float>(ival) * (1.0f/8388608.0f);
+    }
+};
+
 } // namespace al
 
 #endif /* CORE_FMT_TRAITS_H */
@@ -1,5 +1,6 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "hrtf.h"
 
@@ -26,6 +27,12 @@
 #include <utility>
 #include <vector>
 
+#if HAVE_SSE_INTRINSICS
+#include <xmmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "almalloc.h"
 #include "alnumeric.h"
 #include "alstring.h"
@@ -220,14 +227,81 @@ IdxBlend CalcAzIndex(uint azcount, float az)
     return IdxBlend{idx%azcount, az-static_cast<float>(idx)};
 }
 
+/* Blends the four HRIRs with the given weights, on top of the passthru
+ * coefficient for the first sample. The weighted HRIRs are accumulated in
+ * order, all in one pass over the output.
+ */
+void BlendHrirs(const std::array<ConstHrirSpan,4> &hrirs, const std::array<float,4> &blend,
+    const float passthru, const HrirSpan coeffs)
+{
+#if HAVE_SSE_INTRINSICS
+    const auto src0 = reinterpret_cast<const float*>(hrirs[0].data());
+    const auto src1 = reinterpret_cast<const float*>(hrirs[1].data());
+    const auto src2 = reinterpret_cast<const float*>(hrirs[2].data());
+    const auto src3 = reinterpret_cast<const float*>(hrirs[3].data());
+    const auto dst = reinterpret_cast<float*>(coeffs.data());
+    const auto m0 = _mm_set1_ps(blend[0]);
+    const auto m1 = _mm_set1_ps(blend[1]);
+    const auto m2 = _mm_set1_ps(blend[2]);
+    const auto m3 = _mm_set1_ps(blend[3]);
+
+    auto accum = _mm_setr_ps(passthru, passthru, 0.0f, 0.0f);
+    for(size_t i{0};i < HrirLength*2;i += 4)
+    {
+        accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(&src0[i]), m0));
+        accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(&src1[i]), m1));
+        accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(&src2[i]), m2));
+        accum = _mm_add_ps(accum, _mm_mul_ps(_mm_loadu_ps(&src3[i]), m3));
+        _mm_storeu_ps(&dst[i], accum);
+        accum = _mm_setzero_ps();
+    }
+
+#elif HAVE_NEON
+
+    const auto src0 = reinterpret_cast<const float*>(hrirs[0].data());
+    const auto src1 = reinterpret_cast<const float*>(hrirs[1].data());
+    const auto src2 = reinterpret_cast<const float*>(hrirs[2].data());
+    const auto src3 = reinterpret_cast<const float*>(hrirs[3].data());
+    const auto dst = reinterpret_cast<float*>(coeffs.data());
+    const auto m0 = vdupq_n_f32(blend[0]);
+    const auto m1 = vdupq_n_f32(blend[1]);
+    const auto m2 = vdupq_n_f32(blend[2]);
+    const auto m3 = vdupq_n_f32(blend[3]);
+
+    auto accum = vcombine_f32(vdup_n_f32(passthru), vdup_n_f32(0.0f));
+    for(size_t i{0};i < HrirLength*2;i += 4)
+    {
+        accum = vmlaq_f32(accum, vld1q_f32(&src0[i]), m0);
+        accum = vmlaq_f32(accum, vld1q_f32(&src1[i]), m1);
+        accum = vmlaq_f32(accum, vld1q_f32(&src2[i]), m2);
+        accum = vmlaq_f32(accum, vld1q_f32(&src3[i]), m3);
+        vst1q_f32(&dst[i], accum);
+        accum = vdupq_n_f32(0.0f);
+    }
+
+#else
+
+    coeffs[0] = float2{{passthru, passthru}};
+    std::fill_n(coeffs.begin()+1, size_t{HrirLength-1}, float2{{0.0f, 0.0f}});
+    for(size_t c{0};c < 4;c++)
+    {
+        const float mult{blend[c]};
+        auto blend_coeffs = [mult](const float2 &src, const float2 &coeff) noexcept -> float2
+        { return float2{{src[0]*mult + coeff[0], src[1]*mult + coeff[1]}}; };
+        std::transform(hrirs[c].begin(), hrirs[c].end(), coeffs.begin(), coeffs.begin(),
+            blend_coeffs);
+    }
+#endif
+}
+
 } // namespace
 
 
-/* Calculates static HRIR coefficients and delays for the given polar elevation
- * and azimuth in radians. The coefficients are normalized.
+/* Calculates the HRIRs and quantized blending weights for the given polar
+ * elevation and azimuth in radians.
  */
-void HrtfStore::getCoeffs(float elevation, float azimuth, float distance, float spread,
-    const HrirSpan coeffs, const std::span<uint,2> delays) const
+auto HrtfStore::getBlendKey(float elevation, float azimuth, float distance, float spread) const
+    noexcept -> BlendKey
 {
     const float dirfact{1.0f - (std::numbers::inv_pi_v<float>/2.0f * spread)};
 
@@ -241,32 +315,55 @@ void HrtfStore::getCoeffs(float elevation, float azimuth, float distance, float
     };
     auto field = std::find_if(mFields.begin(), mFields.end()-1, match_field);
 
-    /* Calculate the elevation indices. */
+    /* Calculate the elevation and azimuth indices. */
     const auto elev0 = CalcEvIndex(field->evCount, elevation);
     const size_t elev1_idx{std::min(elev0.idx+1u, field->evCount-1u)};
-    const size_t ir0offset{mElev[ebase + elev0.idx].irOffset};
-    const size_t ir1offset{mElev[ebase + elev1_idx].irOffset};
-
-    /* Calculate azimuth indices. */
     const auto az0 = CalcAzIndex(mElev[ebase + elev0.idx].azCount, azimuth);
     const auto az1 = CalcAzIndex(mElev[ebase + elev1_idx].azCount, azimuth);
 
+    auto quantize = [](const float value, const uint steps) noexcept -> ubyte
+    {
+        return static_cast<ubyte>(std::min(float2uint(value*static_cast<float>(steps) + 0.5f),
+            steps));
+    };
+    return BlendKey{static_cast<ubyte>(std::distance(mFields.begin(), field)),
+        static_cast<ubyte>(elev0.idx), static_cast<ubyte>(az0.idx), static_cast<ubyte>(az1.idx),
+        quantize(elev0.blend, BlendSteps), quantize(az0.blend, BlendSteps),
+        quantize(az1.blend, BlendSteps), quantize(std::max(dirfact, 0.0f), DirFactorSteps)};
+}
+
+/* Calculates static HRIR coefficients and delays for the given blend. The
+ * coefficients are normalized.
+ */
+void HrtfStore::getCoeffs(const BlendKey &key, const HrirSpan coeffs,
+    const std::span<uint,2> delays) const
+{
+    const auto ebase = std::accumulate(mFields.begin(), mFields.begin()+key.field, 0_uz,
+        [](const size_t total, const Field &field) noexcept { return total + field.evCount; });
+    const size_t elev1_idx{std::min(key.elev+1u, mFields[key.field].evCount-1u)};
+    const size_t ir0offset{mElev[ebase + key.elev].irOffset};
+    const size_t ir1offset{mElev[ebase + elev1_idx].irOffset};
+
     /* Calculate the HRIR indices to blend. */
     const std::array<size_t,4> idx{{
-        ir0offset + az0.idx,
-        ir0offset + ((az0.idx+1) % mElev[ebase + elev0.idx].azCount),
-        ir1offset + az1.idx,
-        ir1offset + ((az1.idx+1) % mElev[ebase + elev1_idx].azCount)
+        ir0offset + key.az0,
+        ir0offset + ((key.az0+1u) % mElev[ebase + key.elev].azCount),
+        ir1offset + key.az1,
+        ir1offset + ((key.az1+1u) % mElev[ebase + elev1_idx].azCount)
     }};
 
     /* Calculate bilinear blending weights, attenuated according to the
      * directional panning factor.
      */
+    const float elevblend{static_cast<float>(key.elevBlend) / float{BlendSteps}};
+    const float az0blend{static_cast<float>(key.az0Blend) / float{BlendSteps}};
+    const float az1blend{static_cast<float>(key.az1Blend) / float{BlendSteps}};
+    const float dirfact{static_cast<float>(key.dirFactor) / float{DirFactorSteps}};
     const std::array<float,4> blend{{
-        (1.0f-elev0.blend) * (1.0f-az0.blend) * dirfact,
-        (1.0f-elev0.blend) * (     az0.blend) * dirfact,
-        (     elev0.blend) * (1.0f-az1.blend) * dirfact,
-        (     elev0.blend) * (     az1.blend) * dirfact
+        (1.0f-elevblend) * (1.0f-az0blend) * dirfact,
+        (1.0f-elevblend) * (     az0blend) * dirfact,
+        (     elevblend) * (1.0f-az1blend) * dirfact,
+        (     elevblend) * (     az1blend) * dirfact
     }};
 
     /* Calculate the blended HRIR delays. */
@@ -278,18 +375,49 @@ void HrtfStore::getCoeffs(float elevation, float azimuth, float distance, float
     delays[1] = fastf2u(d * float{1.0f/HrirDelayFracOne});
 
     /* Calculate the blended HRIR coefficients. */
-    auto coeffout = coeffs.begin();
-    coeffout[0][0] = PassthruCoeff * (1.0f-dirfact);
-    coeffout[0][1] = PassthruCoeff * (1.0f-dirfact);
-    std::fill_n(coeffout+1, size_t{HrirLength-1}, std::array{0.0f, 0.0f});
-    for(size_t c{0};c < 4;c++)
+    BlendHrirs(std::array{ConstHrirSpan{mCoeffs[idx[0]]}, ConstHrirSpan{mCoeffs[idx[1]]},
+        ConstHrirSpan{mCoeffs[idx[2]]}, ConstHrirSpan{mCoeffs[idx[3]]}}, blend,
+        PassthruCoeff * (1.0f-dirfact), coeffs);
+}
+
+
+HrtfCoeffCache::~HrtfCoeffCache()
+{
+    if(mStats.mHits > 0 || mStats.mMisses > 0)
+        TRACE("HRTF coefficient cache: {} hits, {} misses, {} evictions", mStats.mHits,
+            mStats.mMisses, mStats.mEvictions);
+}
+
+void HrtfCoeffCache::getCoeffs(const HrtfStore &hrtf, float elevation, float azimuth,
+    float distance, float spread, const HrirSpan coeffs, const std::span<uint,2> delays)
+{
+    const auto key = hrtf.getBlendKey(elevation, azimuth, distance, spread);
+    const auto keys = std::span{mKeys}.first(mCount);
+
+    auto entryidx = static_cast<size_t>(std::distance(keys.begin(),
+        std::find(keys.begin(), keys.end(), key.packed())));
+    if(entryidx < keys.size())
+        ++mStats.mHits;
+    else
     {
-        const float mult{blend[c]};
-        auto blend_coeffs = [mult](const float2 &src, const float2 &coeff) noexcept -> float2
-        { return float2{{src[0]*mult + coeff[0], src[1]*mult + coeff[1]}}; };
-        std::transform(mCoeffs[idx[c]].cbegin(), mCoeffs[idx[c]].cend(), coeffout, coeffout,
-            blend_coeffs);
+        ++mStats.mMisses;
+        if(mCount < sNumEntries)
+            entryidx = mCount++;
+        else
+        {
+            /* Replace the least recently used entry. */
+            entryidx = static_cast<size_t>(std::distance(mLastUse.begin(),
+                std::min_element(mLastUse.begin(), mLastUse.end())));
+            ++mStats.mEvictions;
+        }
+        mKeys[entryidx] = key.packed();
+        hrtf.getCoeffs(key, mEntries[entryidx].mCoeffs, mEntries[entryidx].mDelays);
     }
+    mLastUse[entryidx] = ++mUseCounter;
+
+    const auto &entry = mEntries[entryidx];
+    std::copy(entry.mCoeffs.cbegin(), entry.mCoeffs.cend(), coeffs.begin());
+    std::copy(entry.mDelays.cbegin(), entry.mDelays.cend(), delays.begin());
 }
 
 
@@ -2,7 +2,9 @@
 #define CORE_HRTF_H
 
 #include <array>
+#include <bit>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <span>
@@ -41,8 +43,37 @@ struct alignas(16) HrtfStore {
     std::span<const HrirArray> mCoeffs;
     std::span<const ubyte2> mDelays;
 
+    /* The number of steps the blending weights between neighboring HRIRs, and
+     * the directional factor from the spread, are quantized to.
+     */
+    static constexpr uint BlendSteps{128};
+    static constexpr uint DirFactorSteps{255};
+
+    /* Identifies the HRIRs to blend for a given direction, along with their
+     * quantized blending weights. Packed into 64 bits for quick comparisons.
+     */
+    struct BlendKey {
+        ubyte field;
+        ubyte elev;
+        ubyte az0, az1;
+        ubyte elevBlend, az0Blend, az1Blend;
+        ubyte dirFactor;
+
+        [[nodiscard]]
+        auto packed() const noexcept -> std::uint64_t
+        { return std::bit_cast<std::uint64_t>(*this); }
+    };
+    static_assert(sizeof(BlendKey) == sizeof(std::uint64_t));
+
+    [[nodiscard]]
+    auto getBlendKey(float elevation, float azimuth, float distance, float spread) const noexcept
+        -> BlendKey;
+
+    void getCoeffs(const BlendKey &key, const HrirSpan coeffs, const std::span<uint,2> delays)
+        const;
     void getCoeffs(float elevation, float azimuth, float distance, float spread,
-        const HrirSpan coeffs, const std::span<uint,2> delays) const;
+        const HrirSpan coeffs, const std::span<uint,2> delays) const
+    { getCoeffs(getBlendKey(elevation, azimuth, distance, spread), coeffs, delays); }
 
     void add_ref();
     void dec_ref();
@@ -59,6 +90,42 @@ struct alignas(16) HrtfStore {
 using HrtfStorePtr = al::intrusive_ptr<HrtfStore>;
 
 
+/* Holds recently blended HRIR coefficients, so sources that keep the same
+ * direction, or share a direction with another source, can skip blending new
+ * ones. A device only uses it from its mixer thread, and it needs to be
+ * recreated when the device's HRTF changes.
+ */
+class HrtfCoeffCache {
+public:
+    ~HrtfCoeffCache();
+
+    void getCoeffs(const HrtfStore &hrtf, float elevation, float azimuth, float distance,
+        float spread, const HrirSpan coeffs, const std::span<uint,2> delays);
+
+private:
+    static constexpr size_t sNumEntries{32};
+
+    /* Usage counts, traced when the cache is destroyed. */
+    struct Stats {
+        std::uint64_t mHits{0};
+        std::uint64_t mMisses{0};
+        std::uint64_t mEvictions{0};
+    };
+
+    struct Entry {
+        alignas(16) HrirArray mCoeffs;
+        std::array<uint,2> mDelays;
+    };
+
+    size_t mCount{0};
+    std::uint64_t mUseCounter{0};
+    std::array<std::uint64_t,sNumEntries> mKeys{};
+    std::array<std::uint64_t,sNumEntries> mLastUse{};
+    std::array<Entry,sNumEntries> mEntries{};
+    Stats mStats;
+};
+
+
 struct EvRadians { float value; };
 struct AzRadians { float value; };
 struct AngularPoint {
@@ -1,5 +1,6 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "mastering.h"
 
@@ -7,10 +8,18 @@
 #include <cmath>
 #include <cstddef>
 #include <functional>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <span>
 
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "alnumeric.h"
 #include "opthelpers.h"
 
@@ -19,10 +28,15 @@
 static_assert((BufferLineSize & (BufferLineSize-1)) == 0, "BufferLineSize is not a power of 2");
 
 struct SIMDALIGN SlidingHold {
-    alignas(16) FloatBufferLine mValues;
-    std::array<uint,BufferLineSize> mExpiries;
-    uint mLowerIndex;
-    uint mUpperIndex;
+    /* The last mLength-1 levels from the previous update, followed by the
+     * levels for the current update.
+     */
+    alignas(16) std::array<float,BufferLineSize*2_uz> mValues;
+    /* The running maximums within each mLength-sized segment of mValues, going
+     * forward and backward.
+     */
+    alignas(16) std::array<float,BufferLineSize*2_uz> mForward;
+    alignas(16) std::array<float,BufferLineSize*2_uz> mBackward;
     uint mLength;
 };
 
@@ -33,67 +47,217 @@ template<std::size_t A, typename T, std::size_t N>
 constexpr auto assume_aligned_span(const std::span<T,N> s) noexcept -> std::span<T,N>
 { return std::span<T,N>{std::assume_aligned<A>(s.data()), s.size()}; }
 
-/* This sliding hold follows the input level with an instant attack and a
- * fixed duration hold before an instant release to the next highest level.
- * It is a sliding window maximum (descending maxima) implementation based on
- * Richard Harter's ascending minima algorithm available at:
- *
- *   http://www.richardhartersworld.com/cri/2001/slidingmin.html
+#if HAVE_SSE_INTRINSICS
+
+/* Vectorized natural log and exponent approximations for the side-chain,
+ * following the Cephes single-precision implementations. The log expects
+ * normal, positive input (the side-chain clamps the minimum level), and both
+ * are accurate to within a few ULP of std::log and std::exp. The limited
+ * output stays within 1e-5 (relative) of using std::log and std::exp.
  */
-float UpdateSlidingHold(SlidingHold *Hold, const uint i, const float in)
+auto log4(__m128 x) noexcept -> __m128
 {
-    static constexpr auto mask = uint{BufferLineSize - 1};
-    const auto length = Hold->mLength;
-    const auto values = std::span{Hold->mValues};
-    const auto expiries = std::span{Hold->mExpiries};
-    auto lowerIndex = Hold->mLowerIndex;
-    auto upperIndex = Hold->mUpperIndex;
+    const auto one = _mm_set1_ps(1.0f);
+    const auto bits = _mm_castps_si128(x);
+    auto e = _mm_cvtepi32_ps(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(126)));
+    /* Mantissa in the range [0.5,1). */
+    x = _mm_or_ps(_mm_castsi128_ps(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff))),
+        _mm_set1_ps(0.5f));
+
+    /* Shift the mantissa to the range [sqrt(0.5)-1,sqrt(2)-1). */
+    const auto mask = _mm_cmplt_ps(x, _mm_set1_ps(0.707106781186547524f));
+    e = _mm_sub_ps(e, _mm_and_ps(one, mask));
+    x = _mm_add_ps(_mm_sub_ps(x, one), _mm_and_ps(x, mask));
+
+    const auto z = _mm_mul_ps(x, x);
+    auto y = _mm_set1_ps(7.0376836292e-2f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.1514610310e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.1676998740e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.2420140846e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.4249322787e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-1.6668057665e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(2.0000714765e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(-2.4999993993e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(3.3333331174e-1f));
+    y = _mm_mul_ps(_mm_mul_ps(y, x), z);
+
+    y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(-2.12194440e-4f)));
+    y = _mm_sub_ps(y, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+    return _mm_add_ps(_mm_add_ps(x, y), _mm_mul_ps(e, _mm_set1_ps(0.693359375f)));
+}
 
-    if(i >= expiries[upperIndex])
-        upperIndex = (upperIndex + 1) & mask;
+auto exp4(__m128 x) noexcept -> __m128
+{
+    x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-87.3365447f)), _mm_set1_ps(88.3762626f));
+
+    /* exp(x) = 2^n * exp(r), with n = round(x / ln(2)). */
+    const auto fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+        _mm_set1_ps(0.5f));
+    auto n = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+    n = _mm_sub_ps(n, _mm_and_ps(_mm_cmpgt_ps(n, fx), _mm_set1_ps(1.0f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(0.693359375f)));
+    x = _mm_sub_ps(x, _mm_mul_ps(n, _mm_set1_ps(-2.12194440e-4f)));
+
+    auto y = _mm_set1_ps(1.9875691500e-4f);
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+    y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+    y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(y, x), x), x), _mm_set1_ps(1.0f));
+
+    const auto pow2n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(n), _mm_set1_epi32(127)),
+        23);
+    return _mm_mul_ps(y, _mm_castsi128_ps(pow2n));
+}
 
-    if(in >= values[upperIndex])
-    {
-        values[upperIndex] = in;
-        expiries[upperIndex] = i + length;
-        lowerIndex = upperIndex;
-    }
-    else
-    {
-        auto findLowerIndex = [&lowerIndex,in,values]() noexcept -> bool
-        {
-            do {
-                if(!(in >= values[lowerIndex]))
-                    return true;
-            } while(lowerIndex--);
-            return false;
-        };
-        while(!findLowerIndex())
-            lowerIndex = mask;
+#elif HAVE_NEON
 
-        lowerIndex = (lowerIndex + 1) & mask;
-        values[lowerIndex] = in;
-        expiries[lowerIndex] = i + length;
-    }
+auto log4(float32x4_t x) noexcept -> float32x4_t
+{
+    const auto one = vdupq_n_f32(1.0f);
+    const auto bits = vreinterpretq_s32_f32(x);
+    auto e = vcvtq_f32_s32(vsubq_s32(vshrq_n_s32(bits, 23), vdupq_n_s32(126)));
+    x = vreinterpretq_f32_s32(vorrq_s32(vandq_s32(bits, vdupq_n_s32(0x007fffff)),
+        vreinterpretq_s32_f32(vdupq_n_f32(0.5f))));
+
+    const auto mask = vcltq_f32(x, vdupq_n_f32(0.707106781186547524f));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(one), mask)));
+    x = vaddq_f32(vsubq_f32(x, one),
+        vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), mask)));
+
+    const auto z = vmulq_f32(x, x);
+    auto y = vdupq_n_f32(7.0376836292e-2f);
+    y = vmlaq_f32(vdupq_n_f32(-1.1514610310e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.1676998740e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.2420140846e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.4249322787e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.6668057665e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(2.0000714765e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-2.4999993993e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(3.3333331174e-1f), y, x);
+    y = vmulq_f32(vmulq_f32(y, x), z);
+
+    y = vmlaq_n_f32(y, e, -2.12194440e-4f);
+    y = vmlsq_n_f32(y, z, 0.5f);
+    return vmlaq_n_f32(vaddq_f32(x, y), e, 0.693359375f);
+}
+
+auto exp4(float32x4_t x) noexcept -> float32x4_t
+{
+    x = vminq_f32(vmaxq_f32(x, vdupq_n_f32(-87.3365447f)), vdupq_n_f32(88.3762626f));
+
+    const auto fx = vmlaq_n_f32(vdupq_n_f32(0.5f), x, 1.44269504088896341f);
+    auto n = vcvtq_f32_s32(vcvtq_s32_f32(fx));
+    n = vsubq_f32(n, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(n, fx),
+        vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+    x = vmlsq_n_f32(x, n, 0.693359375f);
+    x = vmlsq_n_f32(x, n, -2.12194440e-4f);
+
+    auto y = vdupq_n_f32(1.9875691500e-4f);
+    y = vmlaq_f32(vdupq_n_f32(1.3981999507e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(8.3334519073e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(4.1665795894e-2f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.6666665459e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(5.0000001201e-1f), y, x);
+    y = vaddq_f32(vmlaq_f32(x, vmulq_f32(y, x), x), vdupq_n_f32(1.0f));
+
+    const auto pow2n = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(127)), 23);
+    return vmulq_f32(y, vreinterpretq_f32_s32(pow2n));
+}
+#endif
 
-    Hold->mLowerIndex = lowerIndex;
-    Hold->mUpperIndex = upperIndex;
+/* Converts the amplitudes to logarithmic, clamping the minimum amplitude to
+ * near-zero.
+ */
+void LogLevels(const std::span<const float> src, const std::span<float> dst) noexcept
+{
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = src.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        _mm_storeu_ps(&dst[i], log4(_mm_max_ps(_mm_loadu_ps(&src[i]), _mm_set1_ps(0.000001f))));
+#elif HAVE_NEON
+    const auto todo = src.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        vst1q_f32(&dst[i], log4(vmaxq_f32(vld1q_f32(&src[i]), vdupq_n_f32(0.000001f))));
+#endif
+    std::transform(src.begin()+ptrdiff_t(i), src.end(), dst.begin()+ptrdiff_t(i),
+        [](const float s) noexcept { return std::log(std::max(0.000001f, s)); });
+}
 
-    return values[upperIndex];
+void ExpLevels(const std::span<float> inout) noexcept
+{
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = inout.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        _mm_storeu_ps(&inout[i], exp4(_mm_loadu_ps(&inout[i])));
+#elif HAVE_NEON
+    const auto todo = inout.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        vst1q_f32(&inout[i], exp4(vld1q_f32(&inout[i])));
+#endif
+    std::transform(inout.begin()+ptrdiff_t(i), inout.end(), inout.begin()+ptrdiff_t(i),
+        [](const float s) noexcept { return std::exp(s); });
 }
 
-void ShiftSlidingHold(SlidingHold *Hold, const uint n)
+/* Calculates dst = max(dst, |src|). */
+void MaxAbs(const std::span<const float> src, const std::span<float> dst) noexcept
 {
-    auto exp_upper = Hold->mExpiries.begin() + Hold->mUpperIndex;
-    if(Hold->mLowerIndex < Hold->mUpperIndex)
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = src.size() & ~3_uz;
+    const auto signmask = _mm_set1_ps(-0.0f);
+    for(;i < todo;i += 4)
     {
-        std::transform(exp_upper, Hold->mExpiries.end(), exp_upper,
-            [n](const uint e) noexcept { return e - n; });
-        exp_upper = Hold->mExpiries.begin();
+        const auto s = _mm_andnot_ps(signmask, _mm_loadu_ps(&src[i]));
+        _mm_storeu_ps(&dst[i], _mm_max_ps(_mm_loadu_ps(&dst[i]), s));
     }
-    const auto exp_lower = Hold->mExpiries.begin() + Hold->mLowerIndex;
-    std::transform(exp_upper, exp_lower+1, exp_upper,
-        [n](const uint e) noexcept { return e - n; });
+#elif HAVE_NEON
+    const auto todo = src.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        vst1q_f32(&dst[i], vmaxq_f32(vld1q_f32(&dst[i]), vabsq_f32(vld1q_f32(&src[i]))));
+#endif
+    std::transform(dst.begin()+ptrdiff_t(i), dst.end(), src.begin()+ptrdiff_t(i),
+        dst.begin()+ptrdiff_t(i),
+        [](const float s0, const float s1) noexcept { return std::max(s0, std::fabs(s1)); });
+}
+
+/* Calculates inout = inout * gains. */
+void ApplyGains(const std::span<const float> gains, const std::span<float> inout) noexcept
+{
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = gains.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        _mm_storeu_ps(&inout[i], _mm_mul_ps(_mm_loadu_ps(&inout[i]), _mm_loadu_ps(&gains[i])));
+#elif HAVE_NEON
+    const auto todo = gains.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        vst1q_f32(&inout[i], vmulq_f32(vld1q_f32(&inout[i]), vld1q_f32(&gains[i])));
+#endif
+    std::transform(gains.begin()+ptrdiff_t(i), gains.end(), inout.begin()+ptrdiff_t(i),
+        inout.begin()+ptrdiff_t(i), std::multiplies{});
+}
+
+/* Calculates dst = max(src0, src1). */
+void MaxOf(const std::span<const float> src0, const std::span<const float> src1,
+    const std::span<float> dst) noexcept
+{
+    auto i = 0_uz;
+#if HAVE_SSE_INTRINSICS
+    const auto todo = dst.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        _mm_storeu_ps(&dst[i], _mm_max_ps(_mm_loadu_ps(&src0[i]), _mm_loadu_ps(&src1[i])));
+#elif HAVE_NEON
+    const auto todo = dst.size() & ~3_uz;
+    for(;i < todo;i += 4)
+        vst1q_f32(&dst[i], vmaxq_f32(vld1q_f32(&src0[i]), vld1q_f32(&src1[i])));
+#endif
+    std::transform(src0.begin()+ptrdiff_t(i), src0.begin()+ptrdiff_t(dst.size()),
+        src1.begin()+ptrdiff_t(i), dst.begin()+ptrdiff_t(i),
+        [](const float s0, const float s1) noexcept { return std::max(s0, s1); });
 }
 
 } // namespace
@@ -110,16 +274,8 @@ void Compressor::linkChannels(const uint SamplesToDo,
     const auto sideChain = std::span{mSideChain}.subspan(mLookAhead, SamplesToDo);
     std::fill_n(sideChain.begin(), sideChain.size(), 0.0f);
 
-    auto fill_max = [sideChain](const FloatBufferLine &input) -> void
-    {
-        const auto buffer = assume_aligned_span<16>(std::span{input});
-        auto max_abs = [](const float s0, const float s1) noexcept -> float
-        { return std::max(s0, std::fabs(s1)); };
-        std::transform(sideChain.begin(), sideChain.end(), buffer.begin(), sideChain.begin(),
-            max_abs);
-    };
     for(const FloatBufferLine &input : OutBuffer)
-        fill_max(input);
+        MaxAbs(assume_aligned_span<16>(std::span{input}).first(SamplesToDo), sideChain);
 }
 
 /* This calculates the squared crest factor of the control signal for the
@@ -162,13 +318,19 @@ void Compressor::peakDetector(const uint SamplesToDo)
 
     /* Clamp the minimum amplitude to near-zero and convert to logarithmic. */
     const auto sideChain = std::span{mSideChain}.subspan(mLookAhead, SamplesToDo);
-    std::transform(sideChain.begin(), sideChain.end(), sideChain.begin(),
-        [](float s) { return std::log(std::max(0.000001f, s)); });
+    LogLevels(sideChain, sideChain);
 }
 
 /* An optional hold can be used to extend the peak detector so it can more
  * solidly detect fast transients.  This is best used when operating as a
  * limiter.
+ *
+ * The hold follows the input level with an instant attack and a fixed
+ * duration hold before an instant release to the next highest level. It is a
+ * sliding window maximum, calculated a block at a time with the van Herk/Gil-
+ * Werman algorithm: the levels are split into segments of the hold length,
+ * and the maximum of each window is the backward running maximum from its
+ * start combined with the forward running maximum to its end.
  */
 void Compressor::peakHoldDetector(const uint SamplesToDo)
 {
@@ -176,16 +338,30 @@ void Compressor::peakHoldDetector(const uint SamplesToDo)
     ASSUME(SamplesToDo <= BufferLineSize);
 
     SlidingHold *hold{mHold.get()};
-    uint i{0};
-    auto detect_peak = [&i,hold](const float x_abs) -> float
+    const auto length = size_t{hold->mLength};
+    ASSUME(length > 1);
+    ASSUME(length < BufferLineSize);
+
+    const auto values = std::span{hold->mValues}.first(length-1 + SamplesToDo);
+    const auto forward = std::span{hold->mForward}.first(values.size());
+    const auto backward = std::span{hold->mBackward}.first(values.size());
+
+    const auto sideChain = std::span{mSideChain}.subspan(mLookAhead, SamplesToDo);
+    LogLevels(sideChain, values.subspan(length-1));
+
+    auto maxf = [](const float a, const float b) noexcept { return std::max(a, b); };
+    for(size_t base{0};base < values.size();base += length)
     {
-        const float x_G{std::log(std::max(0.000001f, x_abs))};
-        return UpdateSlidingHold(hold, i++, x_G);
-    };
-    auto sideChain = std::span{mSideChain}.subspan(mLookAhead, SamplesToDo);
-    std::transform(sideChain.begin(), sideChain.end(), sideChain.begin(), detect_peak);
+        const auto segment = values.subspan(base, std::min(length, values.size()-base));
+        std::inclusive_scan(segment.begin(), segment.end(), forward.begin()+ptrdiff_t(base),
+            maxf);
+        std::inclusive_scan(segment.rbegin(), segment.rend(),
+            std::make_reverse_iterator(backward.begin()+ptrdiff_t(base+segment.size())), maxf);
+    }
+    MaxOf(backward, forward.subspan(length-1), sideChain);
 
-    ShiftSlidingHold(hold, SamplesToDo);
+    /* Keep the newest levels for the next update's windows. */
+    std::copy(values.end()-ptrdiff_t(length-1), values.end(), values.begin());
 }
 
 /* This is the heart of the feed-forward compressor.  It operates in the log
@@ -207,7 +383,6 @@ void Compressor::gainCompressor(const uint SamplesToDo)
     const float c_est{mGainEstimate};
     const float a_adp{mAdaptCoeff};
     auto lookAhead = mSideChain.cbegin() + mLookAhead;
-    auto crestFactor = mCrestFactor.cbegin();
     float postGain{mPostGain};
     float knee{mKnee};
     float t_att{attack};
@@ -220,6 +395,29 @@ void Compressor::gainCompressor(const uint SamplesToDo)
 
     ASSUME(SamplesToDo > 0);
 
+    /* The attack and release coefficients only depend on the crest factor, so
+     * they can be calculated for the whole update ahead of the gain smoothing.
+     */
+    const bool autoBallistics{autoAttack || autoRelease};
+    if(autoBallistics)
+    {
+        const auto crestFactor = std::span{mCrestFactor}.first(SamplesToDo);
+        const auto attackCoeffs = std::span{mAttackCoeffs}.first(SamplesToDo);
+        const auto releaseCoeffs = std::span{mReleaseCoeffs}.first(SamplesToDo);
+        for(size_t i{0};i < SamplesToDo;++i)
+        {
+            const float y2_crest{crestFactor[i]};
+            const float att{autoAttack ? 2.0f*attack/y2_crest : t_att};
+            const float rel{autoRelease ? 2.0f*release/y2_crest - att : t_rel};
+            attackCoeffs[i] = -1.0f / att;
+            releaseCoeffs[i] = -1.0f / rel;
+        }
+        ExpLevels(attackCoeffs);
+        ExpLevels(releaseCoeffs);
+    }
+    auto attackCoeff = mAttackCoeffs.cbegin();
+    auto releaseCoeff = mReleaseCoeffs.cbegin();
+
     auto sideChain = std::span{mSideChain}.first(SamplesToDo);
     std::transform(sideChain.begin(), sideChain.end(), sideChain.begin(),
         [&](const float input) -> float
@@ -237,16 +435,10 @@ void Compressor::gainCompressor(const uint SamplesToDo)
             (std::fabs(x_over) < knee_h) ? (x_over+knee_h) * (x_over+knee_h) / (2.0f * knee) :
             x_over};
 
-        const float y2_crest{*(crestFactor++)};
-        if(autoAttack)
-        {
-            t_att = 2.0f*attack/y2_crest;
-            a_att = std::exp(-1.0f / t_att);
-        }
-        if(autoRelease)
+        if(autoBallistics)
         {
-            t_rel = 2.0f*release/y2_crest - t_att;
-            a_rel = std::exp(-1.0f / t_rel);
+            a_att = *(attackCoeff++);
+            a_rel = *(releaseCoeff++);
         }
 
         /* Gain smoothing (ballistics) is done via a smooth decoupled peak
@@ -278,8 +470,9 @@ void Compressor::gainCompressor(const uint SamplesToDo)
             postGain = -(c_dev + c_est);
         }
 
-        return std::exp(postGain - y_L);
+        return postGain - y_L;
     });
+    ExpLevels(sideChain);
 
     mLastRelease = y_1;
     mLastAttack = y_L;
@@ -362,8 +555,8 @@ std::unique_ptr<Compressor> Compressor::Create(const size_t NumChans, const floa
         if(hold > 1)
         {
             Comp->mHold = std::make_unique<SlidingHold>();
-            Comp->mHold->mValues[0] = -std::numeric_limits<float>::infinity();
-            Comp->mHold->mExpiries[0] = hold;
+            std::fill_n(Comp->mHold->mValues.begin(), hold-1,
+                -std::numeric_limits<float>::infinity());
             Comp->mHold->mLength = hold;
         }
         Comp->mDelay.resize(NumChans, FloatBufferLine{});
@@ -412,14 +605,8 @@ void Compressor::process(const uint SamplesToDo, const std::span<FloatBufferLine
         signalDelay(SamplesToDo, InOut);
 
     const auto gains = assume_aligned_span<16>(std::span{mSideChain}.first(SamplesToDo));
-    auto apply_comp = [gains](const FloatBufferSpan inout) noexcept -> void
-    {
-        const auto buffer = assume_aligned_span<16>(std::span{inout});
-        std::transform(gains.begin(), gains.end(), buffer.begin(), buffer.begin(),
-            std::multiplies{});
-    };
     for(const FloatBufferSpan inout : InOut)
-        apply_comp(inout);
+        ApplyGains(gains, assume_aligned_span<16>(std::span{inout}));
 
     const auto delayedGains = std::span{mSideChain}.subspan(SamplesToDo, mLookAhead);
     std::copy(delayedGains.begin(), delayedGains.end(), mSideChain.begin());
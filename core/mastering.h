@@ -50,6 +50,8 @@ class SIMDALIGN Compressor {
 
     alignas(16) std::array<float,BufferLineSize*2_uz> mSideChain{};
     alignas(16) std::array<float,BufferLineSize> mCrestFactor{};
+    alignas(16) std::array<float,BufferLineSize> mAttackCoeffs{};
+    alignas(16) std::array<float,BufferLineSize> mReleaseCoeffs{};
 
     std::unique_ptr<SlidingHold> mHold;
     al::vector<FloatBufferLine,16> mDelay;
@@ -17,6 +17,7 @@ struct CTag;
 
 MixerOutFunc MixSamplesOut{Mix_<CTag>};
 MixerOneFunc MixSamplesOne{Mix_<CTag>};
+MixerMatrixFunc MixSamplesMatrix{MixMatrix_<CTag>};
 
 
 auto CalcAmbiCoeffs(const float y, const float z, const float x, const float spread)
@@ -8,6 +8,7 @@
 
 #include "ambidefs.h"
 #include "bufferline.h"
+#include "devformat.h"
 #include "opthelpers.h"
 
 struct MixParams;
@@ -33,6 +34,22 @@ inline void MixSamples(const std::span<const float> InSamples, const std::span<f
     float &CurrentGain, const float TargetGain, const std::size_t Counter)
 { MixSamplesOne(InSamples, OutBuffer, CurrentGain, TargetGain, Counter); }
 
+/* Mixer functions that handle multiple input and output channels with a
+ * constant gain matrix, which has a row of output gains for each input
+ * channel. The inputs and outputs are both mixed from the given offset.
+ */
+using MixerMatrixFunc = void(*)(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const std::size_t Offset,
+    const std::size_t SamplesToDo);
+
+DECL_HIDDEN extern MixerMatrixFunc MixSamplesMatrix;
+inline void MixMatrix(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const std::size_t Offset,
+    const std::size_t SamplesToDo)
+{ MixSamplesMatrix(InSamples, OutBuffer, Gains, Offset, SamplesToDo); }
+
 
 /**
  * Calculates ambisonic encoder coefficients using the X, Y, and Z direction
@@ -9,6 +9,7 @@
 
 #include "core/bufferline.h"
 #include "core/cubic_defs.h"
+#include "core/devformat.h"
 
 struct HrtfChannelState;
 struct HrtfFilter;
@@ -25,6 +26,11 @@ inline constexpr int MixerFracHalf{MixerFracOne >> 1};
 
 inline constexpr float GainSilenceThreshold{0.00001f}; /* -100dB */
 
+/* The number of samples the matrix mixer processes at a time, to keep the
+ * input and output lines it's working on in the L1 cache.
+ */
+inline constexpr size_t MixerMatrixTileSize{256};
+
 
 enum class Resampler : std::uint8_t {
     Point,
@@ -83,6 +89,11 @@ void Mix_(const std::span<const float> InSamples, const std::span<FloatBufferLin
 template<typename InstTag>
 void Mix_(const std::span<const float> InSamples, const std::span<float> OutBuffer,
     float &CurrentGain, const float TargetGain, const size_t Counter);
+template<typename InstTag>
+void MixMatrix_(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const size_t Offset,
+    const size_t SamplesToDo);
 
 template<typename InstTag>
 void MixHrtf_(const std::span<const float> InSamples, const std::span<float2> AccumSamples,
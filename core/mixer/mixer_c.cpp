@@ -1,6 +1,7 @@
 #include "config.h"
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <limits>
 #include <span>
@@ -277,3 +278,36 @@ void Mix_<CTag>(const std::span<const float> InSamples, const std::span<float> O
 
     MixLine(InSamples, OutBuffer, CurrentGain, TargetGain, delta, fade_len, Counter);
 }
+
+template<>
+void MixMatrix_<CTag>(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const size_t Offset,
+    const size_t SamplesToDo)
+{
+    ASSUME(SamplesToDo > 0);
+    ASSUME(InSamples.size() == Gains.size());
+
+    /* Each output sample accumulates the inputs in order, matching a series
+     * of one-input mixes.
+     */
+    for(size_t base{Offset};base < Offset+SamplesToDo;base += MixerMatrixTileSize)
+    {
+        const auto todo = std::min(MixerMatrixTileSize, Offset+SamplesToDo-base);
+        for(size_t out{0};out < OutBuffer.size();++out)
+        {
+            const auto dst = std::span{OutBuffer[out]}.subspan(base, todo);
+            for(size_t c{0};c < InSamples.size();++c)
+            {
+                const auto gain = Gains[c][out];
+                if(!(std::abs(gain) > GainSilenceThreshold))
+                    continue;
+
+                const auto src = std::span{InSamples[c]}.subspan(base, todo);
+                std::transform(src.begin(), src.end(), dst.begin(), dst.begin(),
+                    [gain](const float val, const float dry) noexcept -> float
+                    { return dry + val*gain; });
+            }
+        }
+    }
+}
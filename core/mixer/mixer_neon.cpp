@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <limits>
 #include <span>
@@ -184,6 +185,89 @@ force_inline void MixLine(const std::span<const float> InSamples, const std::spa
     }
 }
 
+/* Mixes a tile of up to MixerMatrixTileSize samples from the given inputs to
+ * four outputs. Each input has four gains, pre-splatted to a vector for each
+ * output, so each block of 8 samples for the 4 outputs stays in registers
+ * while the inputs are accumulated.
+ */
+void MixMatrixQuad(const std::span<const float*const> ins, const std::span<const float> gains,
+    const std::span<float*,4> outs, const size_t todo)
+{
+    size_t pos{0};
+    for(;pos+8 <= todo;pos += 8)
+    {
+        auto a0 = vld1q_f32(&outs[0][pos]), b0 = vld1q_f32(&outs[0][pos+4]);
+        auto a1 = vld1q_f32(&outs[1][pos]), b1 = vld1q_f32(&outs[1][pos+4]);
+        auto a2 = vld1q_f32(&outs[2][pos]), b2 = vld1q_f32(&outs[2][pos+4]);
+        auto a3 = vld1q_f32(&outs[3][pos]), b3 = vld1q_f32(&outs[3][pos+4]);
+        auto gain = gains.begin();
+        for(const float *input : ins)
+        {
+            const auto va = vld1q_f32(&input[pos]);
+            const auto vb = vld1q_f32(&input[pos+4]);
+            const auto g0 = vld1q_f32(&gain[0]);
+            const auto g1 = vld1q_f32(&gain[4]);
+            const auto g2 = vld1q_f32(&gain[8]);
+            const auto g3 = vld1q_f32(&gain[12]);
+            a0 = vmlaq_f32(a0, va, g0); b0 = vmlaq_f32(b0, vb, g0);
+            a1 = vmlaq_f32(a1, va, g1); b1 = vmlaq_f32(b1, vb, g1);
+            a2 = vmlaq_f32(a2, va, g2); b2 = vmlaq_f32(b2, vb, g2);
+            a3 = vmlaq_f32(a3, va, g3); b3 = vmlaq_f32(b3, vb, g3);
+            gain += 16;
+        }
+        vst1q_f32(&outs[0][pos], a0); vst1q_f32(&outs[0][pos+4], b0);
+        vst1q_f32(&outs[1][pos], a1); vst1q_f32(&outs[1][pos+4], b1);
+        vst1q_f32(&outs[2][pos], a2); vst1q_f32(&outs[2][pos+4], b2);
+        vst1q_f32(&outs[3][pos], a3); vst1q_f32(&outs[3][pos+4], b3);
+    }
+    for(;pos < todo;++pos)
+    {
+        for(size_t j{0};j < 4;++j)
+        {
+            auto gain = gains.begin() + ptrdiff_t(j*4);
+            float dry{outs[j][pos]};
+            for(const float *input : ins)
+            {
+                dry += input[pos] * *gain;
+                gain += 16;
+            }
+            outs[j][pos] = dry;
+        }
+    }
+}
+
+/* Mixes a tile from the given inputs to a single output. */
+void MixMatrixSingle(const std::span<const float*const> ins, const std::span<const float> gains,
+    float *output, const size_t todo)
+{
+    size_t pos{0};
+    for(;pos+8 <= todo;pos += 8)
+    {
+        auto a = vld1q_f32(&output[pos]), b = vld1q_f32(&output[pos+4]);
+        auto gain = gains.begin();
+        for(const float *input : ins)
+        {
+            const auto g = vld1q_f32(&gain[0]);
+            a = vmlaq_f32(a, vld1q_f32(&input[pos]), g);
+            b = vmlaq_f32(b, vld1q_f32(&input[pos+4]), g);
+            gain += 4;
+        }
+        vst1q_f32(&output[pos], a);
+        vst1q_f32(&output[pos+4], b);
+    }
+    for(;pos < todo;++pos)
+    {
+        auto gain = gains.begin();
+        float dry{output[pos]};
+        for(const float *input : ins)
+        {
+            dry += input[pos] * *gain;
+            gain += 4;
+        }
+        output[pos] = dry;
+    }
+}
+
 } // namespace
 
 template<>
@@ -489,3 +573,81 @@ void Mix_<NEONTag>(const std::span<const float> InSamples, const std::span<float
 
     MixLine(InSamples, OutBuffer, CurrentGain, TargetGain, delta, fade_len, realign_len, Counter);
 }
+
+template<>
+void MixMatrix_<NEONTag>(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const size_t Offset,
+    const size_t SamplesToDo)
+{
+    ASSUME(SamplesToDo > 0);
+    ASSUME(InSamples.size() == Gains.size());
+    ASSUME(OutBuffer.size() <= MaxOutputChannels);
+
+    /* Silent gains are mixed as 0 rather than skipped, so skip any input that
+     * is silent for all the outputs being mixed.
+     */
+    static constexpr auto audible_gain = [](const float gain) noexcept -> float
+    { return (std::abs(gain) > GainSilenceThreshold) ? gain : 0.0f; };
+
+    static constexpr size_t MaxInputs{64};
+    auto inptrs = std::array<const float*,MaxInputs>{};
+    alignas(16) auto gains = std::array<float,MaxInputs*4*4>{};
+
+    for(size_t base{Offset};base < Offset+SamplesToDo;base += MixerMatrixTileSize)
+    {
+        const auto todo = std::min(MixerMatrixTileSize, Offset+SamplesToDo-base);
+        for(size_t inbase{0};inbase < InSamples.size();inbase += MaxInputs)
+        {
+            const auto inlines = InSamples.subspan(inbase).first(
+                std::min(MaxInputs, InSamples.size()-inbase));
+            const auto ingains = Gains.subspan(inbase, inlines.size());
+
+            size_t out{0};
+            for(;OutBuffer.size()-out >= 4;out += 4)
+            {
+                size_t count{0};
+                for(size_t c{0};c < inlines.size();++c)
+                {
+                    const auto g0 = audible_gain(ingains[c][out+0]);
+                    const auto g1 = audible_gain(ingains[c][out+1]);
+                    const auto g2 = audible_gain(ingains[c][out+2]);
+                    const auto g3 = audible_gain(ingains[c][out+3]);
+                    if(g0 == 0.0f && g1 == 0.0f && g2 == 0.0f && g3 == 0.0f)
+                        continue;
+
+                    inptrs[count] = &inlines[c][base];
+                    vst1q_f32(&gains[count*16 + 0], vdupq_n_f32(g0));
+                    vst1q_f32(&gains[count*16 + 4], vdupq_n_f32(g1));
+                    vst1q_f32(&gains[count*16 + 8], vdupq_n_f32(g2));
+                    vst1q_f32(&gains[count*16 + 12], vdupq_n_f32(g3));
+                    ++count;
+                }
+                if(count == 0)
+                    continue;
+
+                auto outptrs = std::array{&OutBuffer[out+0][base], &OutBuffer[out+1][base],
+                    &OutBuffer[out+2][base], &OutBuffer[out+3][base]};
+                MixMatrixQuad(std::span{inptrs}.first(count), std::span{gains}.first(count*16),
+                    outptrs, todo);
+            }
+            for(;out < OutBuffer.size();++out)
+            {
+                size_t count{0};
+                for(size_t c{0};c < inlines.size();++c)
+                {
+                    const auto g = audible_gain(ingains[c][out]);
+                    if(g == 0.0f)
+                        continue;
+
+                    inptrs[count] = &inlines[c][base];
+                    vst1q_f32(&gains[count*4], vdupq_n_f32(g));
+                    ++count;
+                }
+                if(count > 0)
+                    MixMatrixSingle(std::span{inptrs}.first(count), std::span{gains}.first(count*4),
+                        &OutBuffer[out][base], todo);
+            }
+        }
+    }
+}
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -196,6 +197,89 @@ force_inline void MixLine(const std::span<const float> InSamples, const std::spa
     }
 }
 
+/* Mixes a tile of up to MixerMatrixTileSize samples from the given inputs to
+ * four outputs. Each input has four gains, pre-splatted to a vector for each
+ * output, so each block of 8 samples for the 4 outputs stays in registers
+ * while the inputs are accumulated.
+ */
+void MixMatrixQuad(const std::span<const float*const> ins, const std::span<const float> gains,
+    const std::span<float*,4> outs, const size_t todo)
+{
+    size_t pos{0};
+    for(;pos+8 <= todo;pos += 8)
+    {
+        auto a0 = _mm_loadu_ps(&outs[0][pos]), b0 = _mm_loadu_ps(&outs[0][pos+4]);
+        auto a1 = _mm_loadu_ps(&outs[1][pos]), b1 = _mm_loadu_ps(&outs[1][pos+4]);
+        auto a2 = _mm_loadu_ps(&outs[2][pos]), b2 = _mm_loadu_ps(&outs[2][pos+4]);
+        auto a3 = _mm_loadu_ps(&outs[3][pos]), b3 = _mm_loadu_ps(&outs[3][pos+4]);
+        auto gain = gains.begin();
+        for(const float *input : ins)
+        {
+            const auto va = _mm_loadu_ps(&input[pos]);
+            const auto vb = _mm_loadu_ps(&input[pos+4]);
+            const auto g0 = _mm_load_ps(&gain[0]);
+            const auto g1 = _mm_load_ps(&gain[4]);
+            const auto g2 = _mm_load_ps(&gain[8]);
+            const auto g3 = _mm_load_ps(&gain[12]);
+            a0 = vmadd(a0, va, g0); b0 = vmadd(b0, vb, g0);
+            a1 = vmadd(a1, va, g1); b1 = vmadd(b1, vb, g1);
+            a2 = vmadd(a2, va, g2); b2 = vmadd(b2, vb, g2);
+            a3 = vmadd(a3, va, g3); b3 = vmadd(b3, vb, g3);
+            gain += 16;
+        }
+        _mm_storeu_ps(&outs[0][pos], a0); _mm_storeu_ps(&outs[0][pos+4], b0);
+        _mm_storeu_ps(&outs[1][pos], a1); _mm_storeu_ps(&outs[1][pos+4], b1);
+        _mm_storeu_ps(&outs[2][pos], a2); _mm_storeu_ps(&outs[2][pos+4], b2);
+        _mm_storeu_ps(&outs[3][pos], a3); _mm_storeu_ps(&outs[3][pos+4], b3);
+    }
+    for(;pos < todo;++pos)
+    {
+        for(size_t j{0};j < 4;++j)
+        {
+            auto gain = gains.begin() + ptrdiff_t(j*4);
+            float dry{outs[j][pos]};
+            for(const float *input : ins)
+            {
+                dry += input[pos] * *gain;
+                gain += 16;
+            }
+            outs[j][pos] = dry;
+        }
+    }
+}
+
+/* Mixes a tile from the given inputs to a single output. */
+void MixMatrixSingle(const std::span<const float*const> ins, const std::span<const float> gains,
+    float *output, const size_t todo)
+{
+    size_t pos{0};
+    for(;pos+8 <= todo;pos += 8)
+    {
+        auto a = _mm_loadu_ps(&output[pos]), b = _mm_loadu_ps(&output[pos+4]);
+        auto gain = gains.begin();
+        for(const float *input : ins)
+        {
+            const auto g = _mm_load_ps(&gain[0]);
+            a = vmadd(a, _mm_loadu_ps(&input[pos]), g);
+            b = vmadd(b, _mm_loadu_ps(&input[pos+4]), g);
+            gain += 4;
+        }
+        _mm_storeu_ps(&output[pos], a);
+        _mm_storeu_ps(&output[pos+4], b);
+    }
+    for(;pos < todo;++pos)
+    {
+        auto gain = gains.begin();
+        float dry{output[pos]};
+        for(const float *input : ins)
+        {
+            dry += input[pos] * *gain;
+            gain += 4;
+        }
+        output[pos] = dry;
+    }
+}
+
 } // namespace
 
 template<>
@@ -391,3 +475,81 @@ void Mix_<SSETag>(const std::span<const float> InSamples, const std::span<float>
 
     MixLine(InSamples, OutBuffer, CurrentGain, TargetGain, delta, fade_len, realign_len, Counter);
 }
+
+template<>
+void MixMatrix_<SSETag>(const std::span<const FloatBufferLine> InSamples,
+    const std::span<FloatBufferLine> OutBuffer,
+    const std::span<const std::array<float,MaxOutputChannels>> Gains, const size_t Offset,
+    const size_t SamplesToDo)
+{
+    ASSUME(SamplesToDo > 0);
+    ASSUME(InSamples.size() == Gains.size());
+    ASSUME(OutBuffer.size() <= MaxOutputChannels);
+
+    /* Silent gains are mixed as 0 rather than skipped, so skip any input that
+     * is silent for all the outputs being mixed.
+     */
+    static constexpr auto audible_gain = [](const float gain) noexcept -> float
+    { return (std::abs(gain) > GainSilenceThreshold) ? gain : 0.0f; };
+
+    static constexpr size_t MaxInputs{64};
+    auto inptrs = std::array<const float*,MaxInputs>{};
+    alignas(16) auto gains = std::array<float,MaxInputs*4*4>{};
+
+    for(size_t base{Offset};base < Offset+SamplesToDo;base += MixerMatrixTileSize)
+    {
+        const auto todo = std::min(MixerMatrixTileSize, Offset+SamplesToDo-base);
+        for(size_t inbase{0};inbase < InSamples.size();inbase += MaxInputs)
+        {
+            const auto inlines = InSamples.subspan(inbase).first(
+                std::min(MaxInputs, InSamples.size()-inbase));
+            const auto ingains = Gains.subspan(inbase, inlines.size());
+
+            size_t out{0};
+            for(;OutBuffer.size()-out >= 4;out += 4)
+            {
+                size_t count{0};
+                for(size_t c{0};c < inlines.size();++c)
+                {
+                    const auto g0 = audible_gain(ingains[c][out+0]);
+                    const auto g1 = audible_gain(ingains[c][out+1]);
+                    const auto g2 = audible_gain(ingains[c][out+2]);
+                    const auto g3 = audible_gain(ingains[c][out+3]);
+                    if(g0 == 0.0f && g1 == 0.0f && g2 == 0.0f && g3 == 0.0f)
+                        continue;
+
+                    inptrs[count] = &inlines[c][base];
+                    _mm_store_ps(&gains[count*16 + 0], _mm_set1_ps(g0));
+                    _mm_store_ps(&gains[count*16 + 4], _mm_set1_ps(g1));
+                    _mm_store_ps(&gains[count*16 + 8], _mm_set1_ps(g2));
+                    _mm_store_ps(&gains[count*16 + 12], _mm_set1_ps(g3));
+                    ++count;
+                }
+                if(count == 0)
+                    continue;
+
+                auto outptrs = std::array{&OutBuffer[out+0][base], &OutBuffer[out+1][base],
+                    &OutBuffer[out+2][base], &OutBuffer[out+3][base]};
+                MixMatrixQuad(std::span{inptrs}.first(count), std::span{gains}.first(count*16),
+                    outptrs, todo);
+            }
+            for(;out < OutBuffer.size();++out)
+            {
+                size_t count{0};
+                for(size_t c{0};c < inlines.size();++c)
+                {
+                    const auto g = audible_gain(ingains[c][out]);
+                    if(g == 0.0f)
+                        continue;
+
+                    inptrs[count] = &inlines[c][base];
+                    _mm_store_ps(&gains[count*4], _mm_set1_ps(g));
+                    ++count;
+                }
+                if(count > 0)
+                    MixMatrixSingle(std::span{inptrs}.first(count), std::span{gains}.first(count*4),
+                        &OutBuffer[out][base], todo);
+            }
+        }
+    }
+}
@@ -21,6 +21,8 @@ auto NameFromFormat(FmtType type) noexcept -> std::string_view
     case FmtDouble: return "Double"sv;
     case FmtMulaw: return "muLaw"sv;
     case FmtAlaw: return "aLaw"sv;
+    case FmtHalf: return "Half"sv;
+    case FmtInt24: return "Int24"sv;
     case FmtIMA4: return "IMA4 ADPCM"sv;
     case FmtMSADPCM: return "MS ADPCM"sv;
     }
@@ -59,6 +61,8 @@ uint BytesFromFmt(FmtType type) noexcept
     case FmtDouble: return sizeof(double);
     case FmtMulaw: return sizeof(std::uint8_t);
     case FmtAlaw: return sizeof(std::uint8_t);
+    case FmtHalf: return sizeof(std::uint16_t);
+    case FmtInt24: return 3;
     case FmtIMA4: break;
     case FmtMSADPCM: break;
     }
@@ -14,6 +14,8 @@ enum FmtType : unsigned char {
     FmtDouble,
     FmtMulaw,
     FmtAlaw,
+    FmtHalf, /* IEEE binary16 */
+    FmtInt24, /* Packed 3-byte little-endian */
     FmtIMA4,
     FmtMSADPCM,
 };
@@ -1,9 +1,11 @@
 
 #include "config.h"
+#include "config_simd.h"
 
 #include "uhjfilter.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <complex>
 #include <functional>
@@ -12,7 +14,14 @@
 #include <span>
 #include <vector>
 
+#if HAVE_SSE_INTRINSICS
+#include <xmmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 #include "alcomplex.h"
+#include "alnumeric.h"
 #include "core/bufferline.h"
 #include "opthelpers.h"
 #include "pffft.h"
@@ -145,9 +154,91 @@ void processOne(UhjAllPassFilter &self, const std::span<const float, 4> coeffs,
     self.mState = state;
 }
 
+/* The four all-pass sections are each their own recursion, with each section
+ * taking the previous section's output as input. Rather than running them in
+ * series per sample, the SIMD paths keep each section's state in its own lane
+ * and skew them by one sample, so that for each step lane 0 takes the next
+ * input sample while lanes 1-3 take the previous step's output from the lane
+ * below. The last section's output then lags three samples behind the input,
+ * so three extra steps are run to flush it. Lanes without a valid input on
+ * the first and last three steps are masked from updating, leaving the state
+ * the same as if the sections were processed serially.
+ */
 void process(UhjAllPassFilter &self, const std::span<const float,4> coeffs,
     const std::span<const float> src, const bool updateState, const std::span<float> dst)
 {
+#if HAVE_SSE_INTRINSICS
+    const auto count = src.size();
+    const auto lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    const auto fcount = _mm_set1_ps(static_cast<float>(count));
+    const auto coeff4 = _mm_loadu_ps(coeffs.data());
+    auto z0 = _mm_setr_ps(self.mState[0].z[0], self.mState[1].z[0], self.mState[2].z[0],
+        self.mState[3].z[0]);
+    auto z1 = _mm_setr_ps(self.mState[0].z[1], self.mState[1].z[1], self.mState[2].z[1],
+        self.mState[3].z[1]);
+    auto y = _mm_setzero_ps();
+
+    auto proc_step = [&y,&z0,&z1,coeff4](const float in) noexcept
+    {
+        const auto x = _mm_move_ss(_mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 1, 0, 0)),
+            _mm_set_ss(in));
+        y = _mm_add_ps(_mm_mul_ps(x, coeff4), z0);
+        z0 = z1;
+        z1 = _mm_sub_ps(_mm_mul_ps(y, coeff4), x);
+    };
+    auto proc_masked = [&y,&z0,&z1,coeff4,lanes,fcount](const std::size_t step, const float in)
+        noexcept
+    {
+        const auto x = _mm_move_ss(_mm_shuffle_ps(y, y, _MM_SHUFFLE(2, 1, 0, 0)),
+            _mm_set_ss(in));
+        const auto pos = _mm_sub_ps(_mm_set1_ps(static_cast<float>(step)), lanes);
+        const auto mask = _mm_and_ps(_mm_cmpge_ps(pos, _mm_setzero_ps()),
+            _mm_cmplt_ps(pos, fcount));
+        y = _mm_add_ps(_mm_mul_ps(x, coeff4), z0);
+        const auto z1new = _mm_sub_ps(_mm_mul_ps(y, coeff4), x);
+        z0 = _mm_or_ps(_mm_and_ps(mask, z1), _mm_andnot_ps(mask, z0));
+        z1 = _mm_or_ps(_mm_and_ps(mask, z1new), _mm_andnot_ps(mask, z1));
+    };
+    auto get_output = [&y]() noexcept -> float
+    { return _mm_cvtss_f32(_mm_shuffle_ps(y, y, _MM_SHUFFLE(3, 3, 3, 3))); };
+
+#elif HAVE_NEON
+
+    static constexpr auto LaneIndices = std::array{0.0f, 1.0f, 2.0f, 3.0f};
+    const auto count = src.size();
+    const auto lanes = vld1q_f32(LaneIndices.data());
+    const auto fcount = vdupq_n_f32(static_cast<float>(count));
+    const auto coeff4 = vld1q_f32(coeffs.data());
+    const auto z0in = std::array{self.mState[0].z[0], self.mState[1].z[0], self.mState[2].z[0],
+        self.mState[3].z[0]};
+    const auto z1in = std::array{self.mState[0].z[1], self.mState[1].z[1], self.mState[2].z[1],
+        self.mState[3].z[1]};
+    auto z0 = vld1q_f32(z0in.data());
+    auto z1 = vld1q_f32(z1in.data());
+    auto y = vdupq_n_f32(0.0f);
+
+    auto proc_step = [&y,&z0,&z1,coeff4](const float in) noexcept
+    {
+        const auto x = vextq_f32(vdupq_n_f32(in), y, 3);
+        y = vmlaq_f32(z0, x, coeff4);
+        z0 = z1;
+        z1 = vsubq_f32(vmulq_f32(y, coeff4), x);
+    };
+    auto proc_masked = [&y,&z0,&z1,coeff4,lanes,fcount](const std::size_t step, const float in)
+        noexcept
+    {
+        const auto x = vextq_f32(vdupq_n_f32(in), y, 3);
+        const auto pos = vsubq_f32(vdupq_n_f32(static_cast<float>(step)), lanes);
+        const auto mask = vandq_u32(vcgeq_f32(pos, vdupq_n_f32(0.0f)), vcltq_f32(pos, fcount));
+        y = vmlaq_f32(z0, x, coeff4);
+        const auto z1new = vsubq_f32(vmulq_f32(y, coeff4), x);
+        z0 = vbslq_f32(mask, z1, z0);
+        z1 = vbslq_f32(mask, z1new, z1);
+    };
+    auto get_output = [&y]() noexcept -> float { return vgetq_lane_f32(y, 3); };
+
+#else
+
     auto state = self.mState;
 
     auto proc_sample = [&state,coeffs](float x) noexcept -> float
@@ -163,6 +254,49 @@ void process(UhjAllPassFilter &self, const std::span<const float,4> coeffs,
     };
     std::transform(src.begin(), src.end(), dst.begin(), proc_sample);
     if(updateState) [[likely]] self.mState = state;
+#endif
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Fill the pipeline, masking off the sections that haven't received a
+     * sample yet (and any that have already passed the last sample, when
+     * there's fewer than 3).
+     */
+    const auto head = std::min(count, 3_uz);
+    for(size_t i{0};i < head;++i)
+        proc_masked(i, src[i]);
+
+    auto output = dst.begin();
+    for(size_t i{3};i < count;++i)
+    {
+        proc_step(src[i]);
+        *(output++) = get_output();
+    }
+
+    /* Flush the remaining samples through the pipeline, masking off the
+     * sections that have finished.
+     */
+    for(size_t i{count};i < count+3;++i)
+    {
+        proc_masked(i, 0.0f);
+        if(i >= 3)
+            *(output++) = get_output();
+    }
+
+    if(updateState) [[likely]]
+    {
+        auto z0out = std::array<float,4>{};
+        auto z1out = std::array<float,4>{};
+#if HAVE_SSE_INTRINSICS
+        _mm_storeu_ps(z0out.data(), z0);
+        _mm_storeu_ps(z1out.data(), z1);
+#else
+        vst1q_f32(z0out.data(), z0);
+        vst1q_f32(z1out.data(), z1);
+#endif
+        for(size_t i{0};i < 4;++i)
+            self.mState[i].z = {z0out[i], z1out[i]};
+    }
+#endif
 }
 
 } // namespace
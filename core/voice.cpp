@@ -11,6 +11,7 @@
 #include <climits>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -41,6 +42,12 @@
 #include "vector.h"
 #include "voice_change.h"
 
+#if HAVE_SSE_INTRINSICS
+#include <emmintrin.h>
+#elif HAVE_NEON
+#include <arm_neon.h>
+#endif
+
 struct CTag;
 #if HAVE_SSE
 struct SSETag;
@@ -99,6 +106,19 @@ inline MixerOneFunc SelectMixerOne()
     return Mix_<CTag>;
 }
 
+inline MixerMatrixFunc SelectMixerMatrix()
+{
+#if HAVE_NEON
+    if((CPUCapFlags&CPU_CAP_NEON))
+        return MixMatrix_<NEONTag>;
+#endif
+#if HAVE_SSE
+    if((CPUCapFlags&CPU_CAP_SSE))
+        return MixMatrix_<SSETag>;
+#endif
+    return MixMatrix_<CTag>;
+}
+
 inline HrtfMixerFunc SelectHrtfMixer()
 {
 #if HAVE_NEON
@@ -179,6 +199,7 @@ void Voice::InitMixer(std::optional<std::string> resopt)
 
     MixSamplesOut = SelectMixer();
     MixSamplesOne = SelectMixerOne();
+    MixSamplesMatrix = SelectMixerMatrix();
     MixHrtfBlendSamples = SelectHrtfBlendMixer();
     MixHrtfSamples = SelectHrtfMixer();
 }
@@ -292,6 +313,96 @@ inline void LoadSamples(const std::span<float> dstSamples,
     });
 }
 
+#if HAVE_SSE_INTRINSICS
+
+/* Converts four half-float values, zero-extended to 32 bits, to floats. Same
+ * as the scalar conversion in FmtTypeTraits<FmtHalf>.
+ */
+inline auto HalfToFloat4(const __m128i hval) noexcept -> __m128
+{
+    const auto shiftedExp = _mm_set1_epi32(0x7c00 << 13);
+    auto bits = _mm_slli_epi32(_mm_and_si128(hval, _mm_set1_epi32(0x7fff)), 13);
+    const auto exp = _mm_and_si128(bits, shiftedExp);
+    bits = _mm_add_epi32(bits, _mm_set1_epi32((127-15) << 23));
+
+    const auto infnan = _mm_cmpeq_epi32(exp, shiftedExp);
+    bits = _mm_add_epi32(bits, _mm_and_si128(infnan, _mm_set1_epi32((128-16) << 23)));
+
+    const auto zerodenorm = _mm_cmpeq_epi32(exp, _mm_setzero_si128());
+    const auto denorm = _mm_castps_si128(_mm_sub_ps(
+        _mm_castsi128_ps(_mm_add_epi32(bits, _mm_set1_epi32(1 << 23))),
+        _mm_castsi128_ps(_mm_set1_epi32(113 << 23))));
+    bits = _mm_or_si128(_mm_and_si128(zerodenorm, denorm), _mm_andnot_si128(zerodenorm, bits));
+
+    const auto sign = _mm_slli_epi32(_mm_and_si128(hval, _mm_set1_epi32(0x8000)), 16);
+    return _mm_castsi128_ps(_mm_or_si128(bits, sign));
+}
+
+#elif HAVE_NEON
+
+inline auto HalfToFloat4(const uint32x4_t hval) noexcept -> float32x4_t
+{
+    const auto shiftedExp = vdupq_n_u32(0x7c00u << 13);
+    auto bits = vshlq_n_u32(vandq_u32(hval, vdupq_n_u32(0x7fffu)), 13);
+    const auto exp = vandq_u32(bits, shiftedExp);
+    bits = vaddq_u32(bits, vdupq_n_u32((127u-15u) << 23));
+
+    const auto infnan = vceqq_u32(exp, shiftedExp);
+    bits = vaddq_u32(bits, vandq_u32(infnan, vdupq_n_u32((128u-16u) << 23)));
+
+    const auto zerodenorm = vceqq_u32(exp, vdupq_n_u32(0u));
+    const auto denorm = vreinterpretq_u32_f32(vsubq_f32(
+        vreinterpretq_f32_u32(vaddq_u32(bits, vdupq_n_u32(1u << 23))),
+        vreinterpretq_f32_u32(vdupq_n_u32(113u << 23))));
+    bits = vbslq_u32(zerodenorm, denorm, bits);
+
+    const auto sign = vshlq_n_u32(vandq_u32(hval, vdupq_n_u32(0x8000u)), 16);
+    return vreinterpretq_f32_u32(vorrq_u32(bits, sign));
+}
+#endif
+
+template<>
+inline void LoadSamples<FmtHalf>(const std::span<float> dstSamples,
+    const std::span<const std::byte> srcData, const size_t srcChan, const size_t srcOffset,
+    const size_t srcStep, const size_t samplesPerBlock [[maybe_unused]]) noexcept
+{
+    using TypeTraits = al::FmtTypeTraits<FmtHalf>;
+    using SampleType = typename TypeTraits::Type;
+    assert(srcChan < srcStep);
+
+    const auto src = std::span{reinterpret_cast<const SampleType*>(srcData.data()),
+        srcData.size()/sizeof(SampleType)};
+    auto srcidx = srcOffset*srcStep + srcChan;
+    auto dst = dstSamples.begin();
+
+#if HAVE_SSE_INTRINSICS || HAVE_NEON
+    /* Convert four samples at a time, gathering them from the interleaved
+     * source as needed.
+     */
+    for(size_t todo{dstSamples.size()>>2};todo;--todo)
+    {
+#if HAVE_SSE_INTRINSICS
+        const auto hval = _mm_setr_epi32(src[srcidx], src[srcidx + srcStep],
+            src[srcidx + srcStep*2], src[srcidx + srcStep*3]);
+        _mm_storeu_ps(std::to_address(dst), HalfToFloat4(hval));
+#else
+        const auto hvals = std::array<uint32_t,4>{src[srcidx], src[srcidx + srcStep],
+            src[srcidx + srcStep*2], src[srcidx + srcStep*3]};
+        vst1q_f32(std::to_address(dst), HalfToFloat4(vld1q_u32(hvals.data())));
+#endif
+        srcidx += srcStep*4;
+        dst += 4;
+    }
+#endif
+
+    std::generate(dst, dstSamples.end(), [&src,&srcidx,srcStep]
+    {
+        const auto ret = TypeTraits{}(src[srcidx]);
+        srcidx += srcStep;
+        return ret;
+    });
+}
+
 template<>
 inline void LoadSamples<FmtIMA4>(std::span<float> dstSamples, std::span<const std::byte> src,
     const size_t srcChan, const size_t srcOffset, const size_t srcStep,
@@ -506,6 +617,8 @@ void LoadSamples(const std::span<float> dstSamples, const std::span<const std::b
     HANDLE_FMT(FmtDouble);
     HANDLE_FMT(FmtMulaw);
     HANDLE_FMT(FmtAlaw);
+    HANDLE_FMT(FmtHalf);
+    HANDLE_FMT(FmtInt24);
     HANDLE_FMT(FmtIMA4);
     HANDLE_FMT(FmtMSADPCM);
     }
@@ -692,24 +805,27 @@ void DoNfcMix(const std::span<const float> samples, std::span<FloatBufferLine> O
     DirectParams &parms, const std::span<const float,MaxOutputChannels> OutGains,
     const uint Counter, const uint OutPos, DeviceBase *Device)
 {
-    using FilterProc = void(NfcFilter::*)(const std::span<const float>, const std::span<float>);
-    static constexpr auto NfcProcess = std::array{FilterProc{nullptr}, &NfcFilter::process1,
-        &NfcFilter::process2, &NfcFilter::process3, &NfcFilter::process4};
-    static_assert(NfcProcess.size() == MaxAmbiOrder+1);
-
     MixSamples(samples, std::span{OutBuffer[0]}.subspan(OutPos), parms.Gains.Current[0],
         OutGains[0], Counter);
     OutBuffer = OutBuffer.subspan(1);
     auto CurrentGains = std::span{parms.Gains.Current}.subspan(1);
     auto TargetGains = OutGains.subspan(1);
 
-    const auto nfcsamples = std::span{Device->ExtraSampleData}.first(samples.size());
+    /* With higher-order output, the filters for all orders are run together,
+     * each order's samples following the previous.
+     */
+    const auto count = samples.size();
+    const auto nfcsamples = std::span{Device->NfcSampleData}.first(count*MaxAmbiOrder);
+    if(Device->NumChannelsPerOrder[2] > 0)
+        parms.NFCtrlFilter.processAll(samples, nfcsamples);
+    else
+        parms.NFCtrlFilter.process1(samples, nfcsamples.first(count));
+
     size_t order{1};
     while(const size_t chancount{Device->NumChannelsPerOrder[order]})
     {
-        (parms.NFCtrlFilter.*NfcProcess[order])(samples, nfcsamples);
-        MixSamples(nfcsamples, OutBuffer.first(chancount), CurrentGains, TargetGains, Counter,
-            OutPos);
+        MixSamples(nfcsamples.subspan((order-1)*count, count), OutBuffer.first(chancount),
+            CurrentGains, TargetGains, Counter, OutPos);
         if(++order == MaxAmbiOrder+1)
             break;
         OutBuffer = OutBuffer.subspan(chancount);
@@ -718,6 +834,47 @@ void DoNfcMix(const std::span<const float> samples, std::span<FloatBufferLine> O
     }
 }
 
+/* Applies the gain ramps to the voice's samples, the first of which plays at
+ * the given device time. The gain buffer is used as scratch space when the
+ * gain changes over the update.
+ */
+void ApplyGainRamps(const GainRampList &ramps, const nanoseconds start, const uint sampleRate,
+    const std::span<float*const> samples, const uint count,
+    const std::span<float,BufferLineSize> gainbuf)
+{
+    if(ramps.mCount == 0) [[likely]]
+        return;
+
+    const auto end = start + nanoseconds{seconds{count}}/sampleRate;
+    auto is_steady = [start,end](const GainRamp &ramp) noexcept -> bool
+    { return start >= ramp.mStart+ramp.mDuration || end <= ramp.mStart; };
+
+    const auto active = std::span{ramps.mRamps}.first(ramps.mCount);
+    if(std::all_of(active.begin(), active.end(), is_steady))
+    {
+        const auto gain = ramps.at(start);
+        if(gain == 1.0f) [[likely]]
+            return;
+        for(float *buffer : samples)
+        {
+            const auto dst = std::span{buffer, count};
+            std::transform(dst.begin(), dst.end(), dst.begin(),
+                [gain](const float s) noexcept -> float { return s*gain; });
+        }
+        return;
+    }
+
+    const auto gains = gainbuf.first(count);
+    auto pos = 0_i64;
+    std::generate(gains.begin(), gains.end(), [&ramps,start,sampleRate,&pos]() noexcept -> float
+    { return ramps.at(start + nanoseconds{seconds{pos++}}/sampleRate); });
+    for(float *buffer : samples)
+    {
+        const auto dst = std::span{buffer, count};
+        std::transform(dst.begin(), dst.end(), gains.begin(), dst.begin(), std::multiplies{});
+    }
+}
+
 } // namespace
 
 void Voice::mix(const State vstate, ContextBase *Context, const nanoseconds deviceTime,
@@ -1011,15 +1168,23 @@ void Voice::mix(const State vstate, ContextBase *Context, const nanoseconds devi
     if(mDecoder)
         mDecoder->decode(MixingSamples, samplesToMix, (vstate==Playing));
 
+    ApplyGainRamps(mProps.GainRamps, deviceTime + nanoseconds{seconds{OutPos}}/Device->mSampleRate,
+        Device->mSampleRate, MixingSamples.first(mDuplicateMono ? 1_uz : MixingSamples.size()),
+        samplesToMix, Device->FilteredData);
+
     if(mFlags.test(VoiceIsAmbisonic))
     {
-        auto chandata = mChans.begin();
-        for(const auto &voiceSamples : MixingSamples)
+        auto splitters = std::array<BandSplitter*,DeviceBase::MixerChannelsMax>{};
+        auto hfscales = std::array<float,DeviceBase::MixerChannelsMax>{};
+        auto lfscales = std::array<float,DeviceBase::MixerChannelsMax>{};
+        for(size_t chan{0};chan < MixingSamples.size();++chan)
         {
-            chandata->mAmbiSplitter.processScale({voiceSamples, samplesToMix},
-                chandata->mAmbiHFScale, chandata->mAmbiLFScale);
-            ++chandata;
+            splitters[chan] = &mChans[chan].mAmbiSplitter;
+            hfscales[chan] = mChans[chan].mAmbiHFScale;
+            lfscales[chan] = mChans[chan].mAmbiLFScale;
         }
+        BandSplitter::processScaleGroup(std::span{splitters}.first(MixingSamples.size()),
+            MixingSamples, hfscales, lfscales, samplesToMix);
     }
 
     const uint Counter{mFlags.test(VoiceIsFading) ? std::min(samplesToMix, 64u) : 0u};
@@ -1198,6 +1363,44 @@ void Voice::mix(const State vstate, ContextBase *Context, const nanoseconds devi
         }
     }
 
+    if(!mFlags.test(VoiceIsStatic) && !mFlags.test(VoiceIsCallback))
+    {
+        /* Check if the samples left in a non-looping queue dropped below the
+         * watermark. Only enough of the queue is counted to know, and the
+         * event isn't sent again until more gets queued.
+         */
+        if(const uint watermark{mProps.LowWatermark}; watermark > 0 && BufferListItem
+            && !BufferLoopItem)
+        {
+            uint64_t remaining{BufferListItem->mSampleLen
+                - std::min(static_cast<uint>(std::max(DataPosInt, 0)),
+                    BufferListItem->mSampleLen)};
+            auto *next = BufferListItem->mNext.load(std::memory_order_acquire);
+            while(remaining < watermark && next)
+            {
+                remaining += next->mSampleLen;
+                next = next->mNext.load(std::memory_order_acquire);
+            }
+
+            if(remaining >= watermark)
+                mFlags.reset(VoiceLowWatermarkSent);
+            else if(!mFlags.test(VoiceLowWatermarkSent)
+                && enabledevt.test(al::to_underlying(AsyncEnableBits::LowWatermark)))
+            {
+                RingBuffer *ring{Context->mAsyncEvents.get()};
+                auto evt_vec = ring->getWriteVector();
+                if(evt_vec[0].len > 0)
+                {
+                    auto &evt = InitAsyncEvent<AsyncSourceLowWatermarkEvent>(evt_vec[0].buf);
+                    evt.mId = SourceID;
+                    evt.mRemaining = static_cast<uint>(remaining);
+                    ring->writeAdvance(1);
+                    mFlags.set(VoiceLowWatermarkSent);
+                }
+            }
+        }
+    }
+
     if(!BufferListItem)
     {
         /* If the voice just ended, set it to Stopping so the next render
@@ -1209,6 +1412,39 @@ void Voice::mix(const State vstate, ContextBase *Context, const nanoseconds devi
     }
 }
 
+void GainRampList::add(const float gain, const nanoseconds start, const nanoseconds duration)
+    noexcept
+{
+    const auto from = at(start);
+
+    auto ramps = std::span{mRamps}.first(mCount);
+    auto iter = std::lower_bound(ramps.begin(), ramps.end(), start,
+        [](const GainRamp &ramp, const nanoseconds t) noexcept -> bool
+        { return ramp.mStart < t; });
+    mCount = static_cast<std::size_t>(std::distance(ramps.begin(), iter));
+    if(mCount == mRamps.size())
+    {
+        std::move(mRamps.begin()+1, mRamps.end(), mRamps.begin());
+        --mCount;
+    }
+    mRamps[mCount++] = GainRamp{from, gain, start, duration};
+}
+
+void GainRampList::dropFinished(const nanoseconds time) noexcept
+{
+    const auto ramps = std::span{mRamps}.first(mCount);
+    auto iter = std::upper_bound(ramps.begin(), ramps.end(), time,
+        [](const nanoseconds t, const GainRamp &ramp) noexcept -> bool
+        { return t < ramp.mStart; });
+    /* Ramps before the one in effect are superseded, and the one in effect is
+     * dropped too if it finished before the given time.
+     */
+    if(iter != ramps.begin() && time <= std::prev(iter)->mStart+std::prev(iter)->mDuration)
+        --iter;
+    const auto end = std::move(iter, ramps.end(), ramps.begin());
+    mCount = static_cast<std::size_t>(std::distance(ramps.begin(), end));
+}
+
 void Voice::prepare(DeviceBase *device)
 {
     /* Even if storing really high order ambisonics, we only mix channels for
@@ -1,6 +1,7 @@
 #ifndef CORE_VOICE_H
 #define CORE_VOICE_H
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <bitset>
@@ -109,6 +110,60 @@ protected:
 };
 
 
+/* A linear gain ramp scheduled on the device clock. */
+struct GainRamp {
+    float mFrom{1.0f};
+    float mTo{1.0f};
+    std::chrono::nanoseconds mStart{};
+    std::chrono::nanoseconds mDuration{};
+
+    [[nodiscard]] auto at(const std::chrono::nanoseconds time) const noexcept -> float
+    {
+        if(time >= mStart+mDuration) return mTo;
+        if(time <= mStart) return mFrom;
+        const auto frac = std::chrono::duration<double>{time-mStart}
+            / std::chrono::duration<double>{mDuration};
+        return mFrom + (mTo-mFrom)*static_cast<float>(frac);
+    }
+};
+
+/* Gain ramps in order of their start times. Each ramp starts from the gain
+ * the earlier ramps give at its start time, and the last ramp to have started
+ * is in effect.
+ */
+struct GainRampList {
+    static constexpr std::size_t MaxRamps{8};
+
+    std::array<GainRamp,MaxRamps> mRamps{};
+    std::size_t mCount{0};
+
+    [[nodiscard]] auto at(const std::chrono::nanoseconds time) const noexcept -> float
+    {
+        const auto ramps = std::span{mRamps}.first(mCount);
+        if(ramps.empty())
+            return 1.0f;
+        auto iter = std::upper_bound(ramps.begin(), ramps.end(), time,
+            [](const std::chrono::nanoseconds t, const GainRamp &ramp) noexcept -> bool
+            { return t < ramp.mStart; });
+        if(iter != ramps.begin())
+            --iter;
+        return iter->at(time);
+    }
+
+    /* Adds a ramp to the given gain, replacing any ramps that start at or
+     * after it. The earliest ramp is dropped if there's no more room.
+     */
+    void add(const float gain, const std::chrono::nanoseconds start,
+        const std::chrono::nanoseconds duration) noexcept;
+
+    /* Removes ramps that finished before the given time or were superseded
+     * by then, so they don't carry over to a new run of the source. Ramps
+     * still in progress, or ending or starting at or after the time, are
+     * kept.
+     */
+    void dropFinished(const std::chrono::nanoseconds time) noexcept;
+};
+
 struct VoiceProps {
     float Pitch;
     float Gain;
@@ -147,6 +202,11 @@ struct VoiceProps {
     float EnhWidth;
     float Panning;
 
+    /* Queued sample count below which to send a low watermark event. */
+    uint LowWatermark;
+
+    GainRampList GainRamps;
+
     /** Direct filter and auxiliary send info. */
     struct DirectData {
         float Gain;
@@ -180,6 +240,7 @@ enum : uint {
     VoiceIsFading,
     VoiceHasHrtf,
     VoiceHasNfc,
+    VoiceLowWatermarkSent,
 
     VoiceFlagCount
 };
@@ -0,0 +1,125 @@
+/* Renders a looping DC source through a loopback device to check when
+ * AL_SOFTX_source_ramp gain ramps apply: a fade-in scheduled before the
+ * source is played must shape its start, and a fade-out that finished during
+ * an earlier run must not silence a replay.
+ */
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "AL/al.h"
+#include "AL/alc.h"
+#include "AL/alext.h"
+#include "inprogext.h"
+
+
+namespace {
+
+constexpr ALCint SampleRate{48000};
+constexpr ALCint64SOFT RampLength{100'000'000}; /* 100ms */
+constexpr ALCsizei RampFrames{SampleRate / 10};
+
+LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+LPALCGETINTEGER64VSOFT alcGetInteger64vSOFT;
+LPALSOURCERAMPFSOFT alSourceRampfSOFT;
+
+int NumFailures{0};
+
+/* Renders the given number of frames, returning the left channel. */
+auto render(ALCdevice *device, const ALCsizei frames) -> std::vector<float>
+{
+    auto stereo = std::vector<float>(static_cast<size_t>(frames)*2);
+    alcRenderSamplesSOFT(device, stereo.data(), frames);
+
+    auto left = std::vector<float>(static_cast<size_t>(frames));
+    for(size_t i{0};i < left.size();++i)
+        left[i] = stereo[i*2];
+    return left;
+}
+
+void check(const char *what, const float value, const float expected, const float level)
+{
+    const auto ok = std::abs(value - expected*level) <= 0.02f*level;
+    std::printf("%s %s: %.4f (expected %.4f)\n", ok ? "PASS" : "FAIL", what, value,
+        expected*level);
+    if(!ok) ++NumFailures;
+}
+
+} // namespace
+
+int main()
+{
+    alcLoopbackOpenDeviceSOFT = reinterpret_cast<LPALCLOOPBACKOPENDEVICESOFT>(
+        alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT"));
+    alcRenderSamplesSOFT = reinterpret_cast<LPALCRENDERSAMPLESSOFT>(
+        alcGetProcAddress(nullptr, "alcRenderSamplesSOFT"));
+    alcGetInteger64vSOFT = reinterpret_cast<LPALCGETINTEGER64VSOFT>(
+        alcGetProcAddress(nullptr, "alcGetInteger64vSOFT"));
+
+    ALCdevice *device{alcLoopbackOpenDeviceSOFT(nullptr)};
+    if(!device)
+    {
+        std::fprintf(stderr, "Failed to open a loopback device\n");
+        return 1;
+    }
+    const auto attrs = std::array<ALCint,11>{ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+        ALC_FORMAT_TYPE_SOFT, ALC_FLOAT_SOFT, ALC_FREQUENCY, SampleRate, ALC_HRTF_SOFT,
+        ALC_FALSE, ALC_OUTPUT_LIMITER_SOFT, ALC_FALSE, 0};
+    ALCcontext *context{alcCreateContext(device, attrs.data())};
+    if(!context || !alcMakeContextCurrent(context))
+    {
+        std::fprintf(stderr, "Failed to set up a loopback context\n");
+        return 1;
+    }
+    alSourceRampfSOFT = reinterpret_cast<LPALSOURCERAMPFSOFT>(
+        alGetProcAddress("alSourceRampfSOFT"));
+
+    auto samples = std::vector<float>(SampleRate, 0.5f);
+    ALuint buffer{}, source{};
+    alGenBuffers(1, &buffer);
+    alBufferData(buffer, AL_FORMAT_MONO_FLOAT32, samples.data(),
+        static_cast<ALsizei>(samples.size()*sizeof(float)), SampleRate);
+    alGenSources(1, &source);
+    alSourcei(source, AL_BUFFER, static_cast<ALint>(buffer));
+    alSourcei(source, AL_LOOPING, AL_TRUE);
+    alSourcei(source, AL_SOURCE_RELATIVE, AL_TRUE);
+
+    /* Fade in over the first 100ms, scheduled before the source plays. */
+    auto clock = ALCint64SOFT{};
+    alcGetInteger64vSOFT(device, ALC_DEVICE_CLOCK_SOFT, 1, &clock);
+    alSourceRampfSOFT(source, AL_RAMP_GAIN_SOFT, 0.0f, clock, 0);
+    alSourceRampfSOFT(source, AL_RAMP_GAIN_SOFT, 1.0f, clock, RampLength);
+    alSourcePlay(source);
+
+    const auto fadein = render(device, RampFrames);
+    const auto level = render(device, RampFrames).back();
+    check("fade-in at 25%", fadein[RampFrames/4], 0.25f, level);
+    check("fade-in at 75%", fadein[RampFrames*3/4], 0.75f, level);
+
+    /* Fade out, stop, and play again. The finished fade-out is dropped. */
+    alcGetInteger64vSOFT(device, ALC_DEVICE_CLOCK_SOFT, 1, &clock);
+    alSourceRampfSOFT(source, AL_RAMP_GAIN_SOFT, 0.0f, clock, RampLength);
+    const auto fadeout = render(device, RampFrames*2);
+    check("fade-out at 50%", fadeout[RampFrames/2], 0.5f, level);
+    check("fade-out end", fadeout.back(), 0.0f, level);
+    alSourceStop(source);
+    alSourcePlay(source);
+    check("replay", render(device, RampFrames).back(), 1.0f, level);
+
+    if(alGetError() != AL_NO_ERROR)
+    {
+        std::printf("FAIL AL error\n");
+        ++NumFailures;
+    }
+
+    alDeleteSources(1, &source);
+    alDeleteBuffers(1, &buffer);
+    alcMakeContextCurrent(nullptr);
+    alcDestroyContext(context);
+    alcCloseDevice(device);
+
+    return NumFailures ? 1 : 0;
+}